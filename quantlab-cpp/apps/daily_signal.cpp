@@ -0,0 +1,64 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include "../src/data/data_source.hpp"
+#include "../src/strategy/mean_reversion_strategy.hpp"
+#include "../src/core/profiler.hpp"
+
+// Incremental daily signal: resume yesterday's indicator state, feed only the new bars,
+// persist the updated state and print today's signal.
+// The first run (or a run with a missing / incompatible state file) loads the full history.
+//
+// Usage: daily_signal [SYMBOL] [STATE_FILE] [DAYS] [CONFIDENCE]
+int main(int argc, char* argv[]) {
+    quantlab::core::profiling::Session profiling_session;  // QUANTLAB_PROFILE=1 / QUANTLAB_TRACE=<file>
+    std::string symbol = argc > 1 ? argv[1] : "TSLA";
+    std::transform(symbol.begin(), symbol.end(), symbol.begin(), ::toupper);
+    std::string state_path = argc > 2 ? argv[2] : symbol + ".qlstate";
+    int days = argc > 3 ? std::atoi(argv[3]) : 120;
+    if (days <= 30) days = 120;
+    double confidence_threshold = argc > 4 ? std::atof(argv[4]) : 0.65;
+    if (confidence_threshold <= 0.0 || confidence_threshold > 1.0) confidence_threshold = 0.65;
+
+    try {
+        auto client = quantlab::data::make_data_source_from_env();  // QUANTLAB_DATA_SOURCE=synthetic runs offline
+        quantlab::strategy::MeanReversionStrategy strategy(client);
+        bool resumed = strategy.restore_state_file(state_path, symbol, "1Day");  // Another symbol's state is refused
+        strategy.set_confidence_threshold(confidence_threshold);  // After the restore, which brings back the saved one
+        size_t new_bars = 0;
+        if (resumed) {
+            new_bars = strategy.catch_up(symbol, "1Day");
+            std::cout << "♻️  Resumed " << symbol << " from " << state_path << " (+" << new_bars << " bars)" << std::endl;
+        } else {
+            std::cout << "📊 Loading " << days << " days of history for " << symbol << "..." << std::endl;
+            strategy.load_aggregated_historical_data(symbol, "1Day", days, 1);
+        }
+
+        // Persist before the live quote touches the indicators
+        if (strategy.save_state_file(state_path)) {
+            std::cout << "💾 Saved state to " << state_path << std::endl;
+        }
+
+        auto signal = strategy.generate_signal(symbol);
+
+        std::cout << "\n{" << std::endl;
+        std::cout << "  \"symbol\": \"" << symbol << "\",\n";
+        std::cout << "  \"resumed\": " << (resumed ? "true" : "false") << ",\n";
+        std::cout << "  \"new_bars\": " << new_bars << ",\n";
+        std::cout << "  \"last_bar_timestamp_ns\": " << strategy.last_bar_timestamp_ns() << ",\n";
+        std::cout << "  \"signal\": \"" << (signal.signal == quantlab::strategy::Signal::BUY ? "BUY" :
+                                            signal.signal == quantlab::strategy::Signal::SELL ? "SELL" : "HOLD") << "\",\n";
+        std::cout << "  \"price\": " << std::fixed << std::setprecision(2) << signal.current_price << ",\n";
+        std::cout << "  \"rsi\": " << std::fixed << std::setprecision(2) << signal.rsi_value << ",\n";
+        std::cout << "  \"confidence\": " << std::fixed << std::setprecision(4) << signal.confidence << "\n";
+        std::cout << "}" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
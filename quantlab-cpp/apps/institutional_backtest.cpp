@@ -4,11 +4,112 @@
 #include <cstring>
 #include <string>
 #include <algorithm>
+#include <vector>
+#include "../src/core/profiler.hpp"
 #include "../src/strategy/mean_reversion_strategy.hpp"
 #include "../src/backtest/backtest_engine.hpp"
+#include "../src/backtest/strategy_runner.hpp"
+#include "../src/backtest/multi_asset_backtest.hpp"
+#include "../src/data/multi_symbol_loader.hpp"
+
+// Split "AAPL,MSFT,NVDA" into upper-cased tickers (empty entries skipped)
+static std::vector<std::string> parse_symbols(const std::string& list) {
+    std::vector<std::string> symbols;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        std::string symbol = list.substr(start, comma - start);
+        if (!symbol.empty()) symbols.push_back(symbol);
+        start = comma + 1;
+    }
+    return symbols;
+}
+
+// Whole universe in one pass over the merged timeline, sharing one $1M portfolio
+static int run_portfolio_backtest(const std::vector<std::string>& symbols, int days, double confidence_threshold,
+                                  int oversold_threshold, int overbought_threshold) {
+    std::cout << "QUANTLAB BACKTESTING ENGINE" << std::endl;
+    std::cout << symbols.size() << "-Symbol Mean Reversion Portfolio Analysis" << std::endl;
+    std::cout << "Days: " << days << " | Confidence Threshold: " << (confidence_threshold * 100) << "%" << std::endl;
+
+    auto client = quantlab::data::make_data_source_from_env();  // QUANTLAB_DATA_SOURCE=synthetic runs offline
+    client->test_connection();
+
+    std::cout << "\n📊 Loading historical data..." << std::endl;
+    quantlab::data::MultiSymbolLoader loader(*client);
+    auto bars_by_symbol = loader.load(symbols, "1Day", days);
+
+    // Columns must outlive the backtest (it borrows views); sized once so they never move
+    std::vector<quantlab::core::BarColumns> columns(symbols.size());
+    quantlab::backtest::MultiAssetBacktest backtest(1000000.0); // $1M starting capital
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        const auto& bars = bars_by_symbol[symbols[i]];
+        if (bars.empty()) {
+            std::cerr << "⚠️  No data for " << symbols[i] << ", leaving it out of the portfolio" << std::endl;
+            continue;
+        }
+        columns[i] = quantlab::core::BarColumns(bars);
+        
+        quantlab::strategy::MeanReversionStrategy strategy(client);
+        strategy.set_confidence_threshold(confidence_threshold);
+        backtest.add_symbol(symbols[i], columns[i].view(), std::move(strategy), confidence_threshold);
+    }
+    
+    std::cout << "\nRunning portfolio backtest..." << std::endl;
+    auto summary = backtest.run();
+    
+    std::cout << "\n{" << std::endl;
+    std::cout << "  \"success\": true,\n";
+    std::cout << "  \"timestamp\": \"" << __DATE__ << "T" << __TIME__ << "\",\n";
+    std::cout << "  \"optimization_results\": [\n";
+    for (size_t i = 0; i < summary.assets.size(); ++i) {
+        const auto& asset = summary.assets[i];
+        double asset_return_pct = asset.return_contribution_pct;
+        std::cout << "    {\n";
+        std::cout << "      \"symbol\": \"" << asset.symbol << "\",\n";
+        std::cout << "      \"rsi_period_min\": 14,\n";
+        std::cout << "      \"rsi_period_max\": 14,\n";
+        std::cout << "      \"oversold_threshold\": " << oversold_threshold << ",\n";
+        std::cout << "      \"overbought_threshold\": " << overbought_threshold << ",\n";
+        std::cout << "      \"total_return\": " << std::fixed << std::setprecision(4) << (asset_return_pct / 100.0) << ",\n";
+        std::cout << "      \"total_return_pct\": " << std::fixed << std::setprecision(2) << asset_return_pct << ",\n";
+        std::cout << "      \"max_drawdown\": " << std::fixed << std::setprecision(4) << (-asset.max_drawdown_contribution_pct / 100.0) << ",\n";
+        std::cout << "      \"sharpe_ratio\": " << std::fixed << std::setprecision(4) << asset.sharpe_ratio << ",\n";
+        std::cout << "      \"total_trades\": " << asset.total_trades << ",\n";
+        std::cout << "      \"winning_trades\": " << asset.winning_trades << ",\n";
+        std::cout << "      \"win_rate\": " << std::fixed << std::setprecision(2) << asset.win_rate_pct << ",\n";
+        std::cout << "      \"profit_factor\": " << std::fixed << std::setprecision(2) << asset.profit_factor << "\n";
+        std::cout << "    }" << (i + 1 < summary.assets.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ],\n";
+    std::cout << "  \"portfolio\": {\n";
+    std::cout << "    \"symbols\": " << summary.assets.size() << ",\n";
+    std::cout << "    \"bars_processed\": " << summary.events << ",\n";
+    std::cout << "    \"starting_capital\": " << std::fixed << std::setprecision(2) << summary.starting_capital << ",\n";
+    std::cout << "    \"ending_capital\": " << std::fixed << std::setprecision(2) << summary.ending_capital << ",\n";
+    std::cout << "    \"total_return\": " << std::fixed << std::setprecision(4) << (summary.total_return_pct / 100.0) << ",\n";
+    std::cout << "    \"max_drawdown\": " << std::fixed << std::setprecision(4) << (-summary.max_drawdown_pct / 100.0) << ",\n";
+    std::cout << "    \"sharpe_ratio\": " << std::fixed << std::setprecision(4) << summary.sharpe_ratio << ",\n";
+    std::cout << "    \"sortino_ratio\": " << std::fixed << std::setprecision(4) << summary.sortino_ratio << ",\n";
+    std::cout << "    \"peak_gross_exposure\": " << std::fixed << std::setprecision(2) << summary.peak_gross_exposure << ",\n";
+    std::cout << "    \"total_trades\": " << summary.total_trades << ",\n";
+    std::cout << "    \"winning_trades\": " << summary.winning_trades << ",\n";
+    std::cout << "    \"win_rate\": " << std::fixed << std::setprecision(2) << summary.win_rate_pct << ",\n";
+    std::cout << "    \"profit_factor\": " << std::fixed << std::setprecision(2) << summary.profit_factor << "\n";
+    std::cout << "  },\n";
+    std::cout << "  \"summary\": {\n";
+    std::cout << "    \"total_combinations\": " << summary.assets.size() << ",\n";
+    std::cout << "    \"best_return\": " << std::fixed << std::setprecision(4) << (summary.total_return_pct / 100.0) << ",\n";
+    std::cout << "    \"avg_trades\": " << (summary.assets.empty() ? 0 : summary.total_trades / static_cast<int>(summary.assets.size())) << "\n";
+    std::cout << "  }\n";
+    std::cout << "}" << std::endl;
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
-    // Parse command line arguments for symbol (default: TSLA)
+    quantlab::core::profiling::Session profiling_session;  // QUANTLAB_PROFILE=1 / QUANTLAB_TRACE=<file>
+    // Parse command line arguments for symbol (default: TSLA; "AAPL,MSFT,..." runs a portfolio)
     std::string symbol = "TSLA";
     if (argc > 1) {
         symbol = argv[1];
@@ -35,13 +136,23 @@ int main(int argc, char* argv[]) {
     // Environment variables should be set via .env file or shell
     // No hardcoded credentials for security
 
+    std::vector<std::string> symbols = parse_symbols(symbol);
+    if (symbols.size() > 1) {
+        try {
+            return run_portfolio_backtest(symbols, days, confidence_threshold, oversold_threshold, overbought_threshold);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     try {
         std::cout << "QUANTLAB BACKTESTING ENGINE" << std::endl;
         std::cout << symbol << " Mean Reversion Strategy Analysis" << std::endl;
         std::cout << "Days: " << days << " | Confidence Threshold: " << (confidence_threshold * 100) << "%" << std::endl;
 
-        // Initialize components
-        auto client = std::make_shared<quantlab::data::AlpacaClient>();
+        // Initialize components (QUANTLAB_DATA_SOURCE=synthetic runs offline)
+        auto client = quantlab::data::make_data_source_from_env();
         
         // Test connection
         client->test_connection();
@@ -68,43 +179,10 @@ int main(int argc, char* argv[]) {
         
         // Initialize backtesting engine
         quantlab::backtest::BacktestEngine engine(1000000.0); // $1M starting capital
-        auto trade_signals = strategy.backtest();
-        
-        // Execute trades based on signals
-        int buy_signals = 0, sell_signals = 0, hold_signals = 0;
-        
-        for (const auto& signal_result : trade_signals) {
-            // Count signal types
-            if (signal_result.signal == quantlab::strategy::Signal::BUY) buy_signals++;
-            else if (signal_result.signal == quantlab::strategy::Signal::SELL) sell_signals++;
-            else hold_signals++;
-            
-            // Execute trades with configurable confidence threshold
-            if (signal_result.signal == quantlab::strategy::Signal::BUY && 
-                signal_result.confidence >= confidence_threshold) {
-                
-                int shares = static_cast<int>(50000 / signal_result.current_price); // $50k per trade
-                engine.get_portfolio().execute_buy(signal_result.current_price, shares, 
-                                                 signal_result.confidence, signal_result.reason);
-            }
-            else if (signal_result.signal == quantlab::strategy::Signal::SELL && 
-                     signal_result.confidence >= confidence_threshold) {
-                
-                if (engine.get_portfolio().shares_held > 0) {
-                    // Sell $50k worth of shares
-                    int shares_to_sell = static_cast<int>(50000 / signal_result.current_price);
-                    int shares = std::min(shares_to_sell, engine.get_portfolio().shares_held);
-                    engine.get_portfolio().execute_sell(signal_result.current_price, shares,
-                                                       signal_result.confidence, signal_result.reason);
-                }
-            }
-        }
-        
-        // Signal counts calculated silently
         
-        // Calculate final metrics using current market price (first signal = most recent)
-        double final_price = trade_signals.empty() ? 413.51 : trade_signals.front().current_price;
-        engine.calculate_final_metrics(final_price);
+        // Event loop: every bar flows signal -> order -> fill -> portfolio ($50k tickets, close fills).
+        // Metrics are marked at the last bar's close (413.51 if there were no signals)
+        quantlab::backtest::run_strategy_backtest(strategy, engine, confidence_threshold, 413.51);
         
         // Get final metrics
         const auto& metrics = engine.get_metrics();
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <cstdlib>
+#include <algorithm>
+#include "../src/data/alpaca_client.hpp"
+#include "../src/data/market_stream.hpp"
+#include "../src/strategy/mean_reversion_strategy.hpp"
+
+// Intraday signals from the streaming feed: every symbol's strategy is warmed up on daily
+// history, then each streamed quote is scored against that daily state (the quote is never
+// fed into the indicators) - no REST call per signal.
+// Prints a line whenever a symbol's signal changes, with the feed-to-signal latency.
+//
+// Usage: live_signal [SYMBOLS] [DAYS] [CONFIDENCE] [SECONDS]
+//   SYMBOLS comma-separated (default AAPL,MSFT,NVDA,TSLA); SECONDS=0 runs until Ctrl-C
+namespace {
+
+std::atomic<bool> stop_requested{false};
+
+void request_stop(int) {
+    stop_requested = true;
+}
+
+const char* signal_name(quantlab::strategy::Signal signal) {
+    return signal == quantlab::strategy::Signal::BUY ? "BUY" :
+           signal == quantlab::strategy::Signal::SELL ? "SELL" : "HOLD";
+}
+
+// Trades kept per symbol for the rolling VWAP (fixed memory however long the session runs)
+constexpr size_t RECENT_TRADES = 1000;
+
+double vwap(const quantlab::core::RingWindow<quantlab::core::Tick>& trades) {
+    double notional = 0.0;
+    int64_t volume = 0;
+    trades.for_each([&](const quantlab::core::Tick& trade) {
+        notional += trade.price * trade.quantity;
+        volume += trade.quantity;
+    });
+    return volume > 0 ? notional / volume : 0.0;
+}
+
+struct LiveSymbol {
+    std::string symbol;
+    std::unique_ptr<quantlab::strategy::MeanReversionStrategy> strategy;
+    std::shared_ptr<quantlab::data::MarketUpdateQueue> updates;
+    quantlab::strategy::Signal last_signal = quantlab::strategy::Signal::HOLD;
+    size_t quotes = 0;
+    size_t trades = 0;
+    quantlab::core::RingTickSeries recent_trades{RECENT_TRADES};
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string symbol_list = argc > 1 ? argv[1] : "AAPL,MSFT,NVDA,TSLA";
+    int days = argc > 2 ? std::atoi(argv[2]) : 120;
+    if (days <= 30) days = 120;
+    double confidence_threshold = argc > 3 ? std::atof(argv[3]) : 0.65;
+    if (confidence_threshold <= 0.0 || confidence_threshold > 1.0) confidence_threshold = 0.65;
+    int seconds = argc > 4 ? std::max(0, std::atoi(argv[4])) : 0;
+
+    try {
+        auto client = std::make_shared<quantlab::data::AlpacaClient>();
+        quantlab::data::MarketDataStream stream;
+
+        std::vector<LiveSymbol> live;
+        std::stringstream list(symbol_list);
+        for (std::string symbol; std::getline(list, symbol, ',');) {
+            if (symbol.empty()) continue;
+            std::transform(symbol.begin(), symbol.end(), symbol.begin(), ::toupper);
+
+            LiveSymbol entry;
+            entry.symbol = symbol;
+            entry.strategy = std::make_unique<quantlab::strategy::MeanReversionStrategy>(client);
+            entry.strategy->set_confidence_threshold(confidence_threshold);
+            std::cout << "📊 Warming up " << symbol << " on " << days << " days of history..." << std::endl;
+            entry.strategy->load_aggregated_historical_data(symbol, "1Day", days, 1);
+            entry.updates = stream.subscribe(symbol);
+            live.push_back(std::move(entry));
+        }
+
+        std::signal(SIGINT, request_stop);
+        std::signal(SIGTERM, request_stop);
+        if (!stream.start()) {
+            return 1;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        while (!stop_requested && (seconds == 0 || std::chrono::steady_clock::now() < deadline)) {
+            bool idle = true;
+            for (auto& entry : live) {
+                // This thread is the only consumer of every queue
+                while (auto update = entry.updates->try_pop()) {
+                    idle = false;
+                    if (update->kind == quantlab::data::MarketUpdate::Kind::TRADE) {
+                        ++entry.trades;
+                        entry.recent_trades.push_back({update->timestamp_ns, update->price, update->size});
+                        continue;
+                    }
+                    if (!update->two_sided()) continue;
+                    ++entry.quotes;
+
+                    auto signal = entry.strategy->preview_signal(update->mid_price());  // Daily indicators stay daily
+                    if (signal.signal == entry.last_signal) continue;
+                    entry.last_signal = signal.signal;
+
+                    auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                    std::cout << std::left << std::setw(6) << entry.symbol << std::setw(5) << signal_name(signal.signal)
+                              << " price " << std::fixed << std::setprecision(2) << signal.current_price
+                              << "  rsi " << signal.rsi_value
+                              << "  confidence " << std::setprecision(4) << signal.confidence
+                              << "  decode->signal " << std::setprecision(1) << (now_ns - update->received_ns) / 1000.0
+                              << " us" << std::endl;
+                }
+            }
+            if (idle) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        stream.stop();
+
+        std::cout << "\n📈 Stream summary: " << stream.received_updates() << " updates, "
+                  << stream.dropped_updates() << " dropped, " << stream.reconnects() << " reconnects" << std::endl;
+        for (const auto& entry : live) {
+            std::cout << "  " << std::left << std::setw(6) << entry.symbol << entry.quotes << " quotes, "
+                      << entry.trades << " trades, last signal " << signal_name(entry.last_signal);
+            if (!entry.recent_trades.empty()) {
+                std::cout << ", VWAP of last " << entry.recent_trades.size() << " trades "
+                          << std::fixed << std::setprecision(2) << vwap(entry.recent_trades.all());
+            }
+            std::cout << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
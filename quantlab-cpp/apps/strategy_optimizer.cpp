@@ -8,42 +8,35 @@
 #include <chrono>
 #include <thread>
 #include <set>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <span>
+#include <optional>
+#include <csignal>
+#include <stdexcept>
+#include <cctype>
+#include <nlohmann/json.hpp>
+#include "../src/core/parallel.hpp"
+#include "../src/core/line_server.hpp"
+#include "../src/core/time_utils.hpp"
+#include "../src/core/profiler.hpp"
+#include "../src/data/multi_symbol_loader.hpp"
+#include "../src/data/mapped_bar_file.hpp"
+#include "../src/indicators/indicator_bank.hpp"
 #include "../src/strategy/mean_reversion_strategy.hpp"
 #include "../src/backtest/backtest_engine.hpp"
+#include "../src/backtest/strategy_runner.hpp"
+#include "../src/optimization/optimization_types.hpp"
+#include "../src/optimization/pruning.hpp"
+#include "../src/optimization/result_export.hpp"
+#include "../src/optimization/result_cache.hpp"
+#include "../src/optimization/search.hpp"
+#include "../src/optimization/walk_forward.hpp"
 
 namespace quantlab::optimization {
 
-/**
- * Parameter set for strategy optimization
- */
-struct ParameterSet {
-    std::string symbol;
-    int days;
-    double confidence_threshold;
-    
-    ParameterSet(const std::string& sym, int d, double conf) 
-        : symbol(sym), days(d), confidence_threshold(conf) {}
-};
-
-/**
- * Optimization result for a single parameter set
- */
-struct OptimizationResult {
-    ParameterSet parameters;
-    double total_return;
-    double max_drawdown;
-    double sharpe_ratio;
-    int total_trades;
-    int winning_trades;
-    double win_rate;
-    double profit_factor;
-    
-    OptimizationResult(const ParameterSet& params) 
-        : parameters(params), total_return(0.0), max_drawdown(0.0), 
-          sharpe_ratio(0.0), total_trades(0), winning_trades(0), 
-          win_rate(0.0), profit_factor(0.0) {}
-};
-
 /**
  * Strategy Optimizer - Automated Parameter Sweep Framework
  * 
@@ -51,34 +44,94 @@ struct OptimizationResult {
  * - Multiple symbols (AAPL, TSLA, NVDA, etc.)
  * - Different time periods (30-365 days)
  * - Various confidence thresholds (0.3-0.9)
+ * - Indicator periods (EMA / RSI / Bollinger) and RSI entry/exit levels
+ * - Or, instead of the full grid, a SearchDriver (random, Latin hypercube,
+ *   TPE, coordinate descent) proposing batches of parameter sets
  * 
  * Features:
  * - Parallel parameter testing
+ * - One indicator pass per (symbol, days) window shared by all its grid points
  * - Performance metrics collection
- * - CSV export for analysis
+ * - Optional early termination of losing configurations (PruningPolicy)
+ * - CSV / JSON export for analysis, binary columnar export for bulk loading
  * - Progress tracking
  */
 class StrategyOptimizer {
 private:
-    std::shared_ptr<quantlab::data::AlpacaClient> client_;
+    std::shared_ptr<quantlab::data::DataSource> client_;
     std::vector<ParameterSet> parameter_grid_;
     std::vector<OptimizationResult> results_;
+    size_t thread_count_;
+    std::shared_ptr<const PruningPolicy> pruning_;  // Null = run every configuration to the end
+    std::shared_ptr<ResultCache> result_cache_;     // Null = always backtest
+    
+    // One symbol's history: a shared memory-mapped bar file when available, otherwise owned columns
+    struct SymbolHistory {
+        quantlab::core::BarColumns owned;
+        std::optional<quantlab::data::MappedBarFile> mapped;
+        int days = 0;             // Longest window it was loaded for
+        int32_t loaded_day = 0;   // UTC epoch day of the load; a long-running optimizer reloads the next day
+        
+        quantlab::core::BarColumnsView view() const { return mapped ? mapped->view() : owned.view(); }
+    };
+    
+    // Longest requested window per symbol, loaded once and shared read-only by every grid point
+    std::unordered_map<std::string, SymbolHistory> symbol_bars_;
+    
+    // Where mapped bar files live: next to the bar cache, so "" when caching is disabled
+    std::string mapped_data_directory() const {
+        const auto* cache = client_->bar_cache();
+        return cache ? cache->directory() : std::string();
+    }
     
 public:
-    StrategyOptimizer(std::shared_ptr<quantlab::data::AlpacaClient> client) 
-        : client_(client) {
+    StrategyOptimizer(std::shared_ptr<quantlab::data::DataSource> client) 
+        : client_(client), thread_count_(quantlab::core::default_thread_count()) {
+    }
+    
+    // Number of grid points evaluated concurrently (defaults to all cores)
+    void set_thread_count(size_t threads) {
+        thread_count_ = std::max<size_t>(1, threads);
+    }
+    
+    // Memoize backtests across runs / requests (may be shared by several optimizers); nullptr turns it off.
+    // Results are reused while the bars they were computed on are unchanged.
+    void set_result_cache(std::shared_ptr<ResultCache> cache) {
+        result_cache_ = std::move(cache);
+    }
+    
+    // Stop configurations early (drawdown cutoffs, successive halving); nullptr turns pruning off.
+    // Applies to grid points evaluated from preloaded data, which is all of them unless a load failed.
+    void set_pruning_policy(std::shared_ptr<const PruningPolicy> policy) {
+        pruning_ = std::move(policy);
     }
     
     // Build parameter grid for optimization
     void build_parameter_grid(const std::vector<std::string>& symbols,
                              const std::vector<int>& days_range,
-                             const std::vector<double>& confidence_range) {
+                             const std::vector<double>& confidence_range,
+                             const std::vector<int>& ema_periods = {20},
+                             const std::vector<int>& rsi_periods = {14},
+                             const std::vector<int>& bb_periods = {20},
+                             const std::vector<int>& rsi_oversold_levels = {30},
+                             const std::vector<int>& rsi_overbought_levels = {70}) {
         parameter_grid_.clear();
         
         for (const auto& symbol : symbols) {
             for (int days : days_range) {
                 for (double confidence : confidence_range) {
-                    parameter_grid_.emplace_back(symbol, days, confidence);
+                    for (int ema : ema_periods) {
+                        for (int rsi : rsi_periods) {
+                            for (int bb : bb_periods) {
+                                for (int oversold : rsi_oversold_levels) {
+                                    for (int overbought : rsi_overbought_levels) {
+                                        parameter_grid_.emplace_back(symbol, days, confidence, ema, rsi, bb,
+                                                                     oversold, overbought);
+                                    }
+                                }
+                            }
+                        }
+                    }
                 }
             }
         }
@@ -87,46 +140,305 @@ public:
                   << " combinations" << std::endl;
         std::cout << "Symbols: " << symbols.size() 
                   << " | Days: " << days_range.size() 
-                  << " | Confidence: " << confidence_range.size() << std::endl;
+                  << " | Confidence: " << confidence_range.size()
+                  << " | EMA/RSI/BB periods: " << ema_periods.size() << "/" << rsi_periods.size()
+                  << "/" << bb_periods.size()
+                  << " | RSI levels: " << rsi_oversold_levels.size() << "x" << rsi_overbought_levels.size() << std::endl;
     }
     
     // Run optimization across all parameter combinations
     void run_optimization() {
-        results_.clear();
-        results_.reserve(parameter_grid_.size());
-        
         std::cout << "\n🚀 Starting optimization run..." << std::endl;
-        std::cout << "Total combinations to test: " << parameter_grid_.size() << std::endl;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        
+        evaluate_grid(true);
         
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time);
+        
+        std::cout << "\n✅ Optimization completed in " << duration.count() 
+                  << " seconds" << std::endl;
+        std::cout << "Generated " << results_.size() << " optimization results" << std::endl;
+        if (pruning_) {
+            size_t pruned = std::count_if(results_.begin(), results_.end(),
+                                          [](const OptimizationResult& r) { return r.pruned; });
+            std::cout << "✂️  Pruned " << pruned << " of " << results_.size() << " configurations early" << std::endl;
+        }
+    }
+    
+    // Let a search driver choose what to backtest: it proposes up to batch_size parameter sets at a
+    // time, each batch is evaluated like a grid, and the results are fed back until it stops.
+    // Every evaluated point ends up in get_results() / the exports, in evaluation order.
+    void run_search(SearchDriver& driver, size_t batch_size = 32) {
+        std::cout << "\n🔎 Starting " << driver.name() << " search..." << std::endl;
         auto start_time = std::chrono::high_resolution_clock::now();
         
+        std::vector<OptimizationResult> all_results;
+        size_t rounds = 0;
+        for (;;) {
+            parameter_grid_ = driver.propose(std::max<size_t>(1, batch_size));
+            if (parameter_grid_.empty()) break;
+            
+            evaluate_grid(false);
+            all_results.insert(all_results.end(), results_.begin(), results_.end());
+            ++rounds;
+            
+            // Failed backtests carry no score: the driver never sees them (it may propose them again)
+            std::erase_if(results_, [](const OptimizationResult& r) { return r.failed; });
+            driver.observe(results_);
+            
+            std::cout << "Round " << rounds << ": " << all_results.size() << " backtests, best return ";
+            auto best = best_result(all_results);
+            if (best) {
+                std::cout << std::fixed << std::setprecision(2) << (best->total_return * 100) << "%" << std::endl;
+            } else {
+                std::cout << "n/a (every backtest failed)" << std::endl;
+            }
+        }
+        results_ = std::move(all_results);
+        
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        std::cout << "\n✅ Search completed in " << duration.count() << " ms: "
+                  << results_.size() << " backtests in " << rounds << " rounds" << std::endl;
+    }
+    
+    // Cross-validate the grid's strategy configurations for `symbol` on its trailing `days` window:
+    // each fold picks the best configuration on its train bars and scores it on its test bars.
+    ValidationReport run_walk_forward(const std::string& symbol, int days, const ValidationConfig& config) {
+        load_symbol_data();
+        auto window = window_for(ParameterSet(symbol, days, 0.0));
+        
+        // One candidate per distinct strategy configuration (the grid's days are irrelevant here)
+        std::vector<ParameterSet> candidates;
+        std::set<decltype(parameter_key(parameter_grid_.front()))> seen;
+        for (const auto& params : parameter_grid_) {
+            if (params.symbol != symbol) continue;
+            ParameterSet candidate = params;
+            candidate.days = days;
+            if (seen.insert(parameter_key(candidate)).second) candidates.push_back(candidate);
+        }
+        
+        std::cout << "\n🔁 Cross-validating " << candidates.size() << " configurations on " << symbol
+                  << " (" << window.size() << " bars, " << config.folds << " folds)" << std::endl;
+        WalkForwardValidator validator(window, std::move(candidates), config);
+        return validator.run();
+    }
+    
+    static void print_validation_report(const ValidationReport& report) {
+        std::cout << std::left << std::setw(6) << "Fold" << std::setw(16) << "Train bars" << std::setw(14) << "Test bars"
+                  << std::setw(24) << "Best (conf/ema/rsi/bb)" << std::setw(12) << "Train%" << std::setw(12) << "Test%"
+                  << std::endl;
+        for (const auto& fold : report.folds) {
+            size_t train_bars = 0;
+            for (const auto& range : fold.train) train_bars += range.size();
+            std::string best = std::to_string(static_cast<int>(fold.best.confidence_threshold * 100)) + "/" +
+                               std::to_string(fold.best.ema_period) + "/" + std::to_string(fold.best.rsi_period) + "/" +
+                               std::to_string(fold.best.bb_period);
+            std::cout << std::left << std::setw(6) << fold.fold << std::setw(16) << train_bars
+                      << std::setw(14) << fold.test.size() << std::setw(24) << best
+                      << std::setw(12) << std::fixed << std::setprecision(2) << (fold.train_score * 100)
+                      << std::setw(12) << std::fixed << std::setprecision(2) << (fold.test_score * 100) << std::endl;
+        }
+        std::cout << "Mean train: " << std::fixed << std::setprecision(2) << (report.mean_train_score * 100)
+                  << "% | Mean test (out-of-sample): " << (report.mean_test_score * 100) << "% | "
+                  << report.checkpoints << " indicator checkpoints" << std::endl;
+    }
+    
+    // Backtest every point of parameter_grid_ into results_ (same order)
+    void evaluate_grid(bool report_progress) {
+        // Pre-size one result slot per grid point so workers write without locking
+        results_.clear();
+        results_.reserve(parameter_grid_.size());
+        for (const auto& params : parameter_grid_) {
+            results_.emplace_back(params);
+        }
+        
+        load_symbol_data();
+        
+        // Grid points already backtested on exactly these bars come from the cache
+        // (versions[i] is set for the misses, which are stored back once backtested)
+        std::vector<std::optional<DataVersion>> versions(parameter_grid_.size());
+        std::vector<char> from_cache(parameter_grid_.size(), 0);
+        size_t cached = 0;
+        if (result_cache_) {
+            for (size_t i = 0; i < parameter_grid_.size(); ++i) {
+                if (!symbol_bars_.count(parameter_grid_[i].symbol)) continue;
+                DataVersion version = DataVersion::of(window_for(parameter_grid_[i]));
+                if (auto hit = result_cache_->find(parameter_grid_[i], version)) {
+                    results_[i] = *hit;
+                    from_cache[i] = 1;
+                    ++cached;
+                } else {
+                    versions[i] = version;
+                }
+            }
+        }
+        
+        // Grid points that share a preloaded (symbol, days) window are evaluated together in one pass
+        std::vector<std::vector<size_t>> batches;
+        std::map<std::pair<std::string, int>, size_t> batch_of;
         for (size_t i = 0; i < parameter_grid_.size(); ++i) {
             const auto& params = parameter_grid_[i];
+            if (from_cache[i]) continue;
+            if (!symbol_bars_.count(params.symbol)) {
+                batches.push_back({i});  // Not preloaded - backtested on its own
+                continue;
+            }
+            auto [it, inserted] = batch_of.try_emplace({params.symbol, params.days}, batches.size());
+            if (inserted) batches.emplace_back();
+            batches[it->second].push_back(i);
+        }
+        
+        if (report_progress) {
+            std::cout << "Total combinations to test: " << parameter_grid_.size() 
+                      << " in " << batches.size() << " data passes on "
+                      << std::min(thread_count_, batches.size()) << " threads" << std::endl;
+            if (cached > 0) {
+                std::cout << "♻️  " << cached << " results reused from the result cache" << std::endl;
+            }
+        }
+        
+        std::atomic<size_t> completed{cached};
+        std::mutex progress_mutex;
+        
+        quantlab::core::parallel_for(batches.size(), thread_count_, [&](size_t b) {
+            const auto& batch = batches[b];
+            if (symbol_bars_.count(parameter_grid_[batch.front()].symbol)) {
+                run_parameter_batch(batch);
+            } else {
+                results_[batch.front()] = run_single_backtest(parameter_grid_[batch.front()]);
+            }
             
             // Progress indicator
-            if (i % 10 == 0 || i == parameter_grid_.size() - 1) {
-                double progress = (double)(i + 1) / parameter_grid_.size() * 100.0;
+            if (!report_progress) return;
+            size_t before = completed.fetch_add(batch.size());
+            size_t done = before + batch.size();
+            if (done / 10 != before / 10 || done == parameter_grid_.size()) {
+                double progress = (double)done / parameter_grid_.size() * 100.0;
+                std::lock_guard<std::mutex> lock(progress_mutex);
                 std::cout << "Progress: " << std::fixed << std::setprecision(1) 
-                          << progress << "% (" << (i + 1) << "/" 
+                          << progress << "% (" << done << "/" 
                           << parameter_grid_.size() << ")" << std::endl;
             }
-            
-            // Run single backtest
-            auto result = run_single_backtest(params);
-            results_.push_back(result);
-            
-            // Rate limiting - small delay between tests
-            if (i < parameter_grid_.size() - 1) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
+        
+        if (result_cache_) {
+            for (size_t i = 0; i < parameter_grid_.size(); ++i) {
+                if (versions[i]) result_cache_->insert(results_[i], *versions[i]);
             }
         }
+    }
+    
+    // Fetch each symbol once, sized to the longest window any grid point asks for
+    void load_symbol_data() {
+        std::map<std::string, int> longest_window;
+        for (const auto& params : parameter_grid_) {
+            int& days = longest_window[params.symbol];
+            days = std::max(days, params.days);
+        }
         
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time);
+        // Reuse what is loaded unless it is from another day or shorter than now asked for
+        const int32_t today = quantlab::core::today_epoch_day();
+        std::vector<quantlab::data::LoadRequest> requests;
+        for (const auto& [symbol, days] : longest_window) {
+            auto it = symbol_bars_.find(symbol);
+            if (it == symbol_bars_.end() || it->second.days < days || it->second.loaded_day != today) {
+                symbol_bars_.erase(symbol);
+                requests.push_back({symbol, days});
+            }
+        }
+        if (requests.empty()) return;
+        
+        // Histories another process (or an earlier run today) already wrote are mapped, not fetched.
+        // Every optimizer on the host then backtests off the same page-cache copy.
+        const std::string directory = mapped_data_directory();
+        if (!directory.empty()) {
+            std::vector<quantlab::data::LoadRequest> to_fetch;
+            for (const auto& request : requests) {
+                auto mapped = quantlab::data::MappedBarFile::open(
+                    quantlab::data::MappedBarFile::path_for(directory, request.symbol, "1Day"));
+                int32_t first_day = quantlab::data::AlpacaClient::aggregated_window_first_day(request.total_days);
+                if (mapped && mapped->covers(first_day, today)) {
+                    SymbolHistory& history = symbol_bars_[request.symbol];
+                    history.mapped = std::move(mapped);
+                    history.days = request.total_days;
+                    history.loaded_day = today;
+                } else {
+                    to_fetch.push_back(request);
+                }
+            }
+            requests = std::move(to_fetch);
+            if (requests.empty()) return;
+        }
         
-        std::cout << "\n✅ Optimization completed in " << duration.count() 
-                  << " seconds" << std::endl;
-        std::cout << "Generated " << results_.size() << " optimization results" << std::endl;
+        std::map<std::string, int> requested_days;
+        for (const auto& request : requests) requested_days[request.symbol] = request.total_days;
+        
+        quantlab::data::MultiSymbolLoader loader(*client_);
+        for (const auto& [symbol, bars] : loader.load(requests, "1Day")) {
+            SymbolHistory& history = symbol_bars_[symbol];
+            history.owned = quantlab::core::BarColumns(bars);
+            history.days = bars.empty() ? 0 : requested_days[symbol];  // A failed load is retried next time
+            history.loaded_day = today;
+            if (directory.empty() || bars.empty()) continue;  // Never persist a failed load
+            
+            // Nor a partial one: days that failed stay uncached so they are retried, and a mapped
+            // file stamped as covering the window would hide them from every later run today
+            int32_t first_day = quantlab::data::AlpacaClient::aggregated_window_first_day(requested_days[symbol]);
+            int32_t last_day = first_day + requested_days[symbol] - 1;
+            if (!client_->bar_cache()->missing_ranges(symbol, "1Day", first_day, last_day).empty()) {
+                std::cerr << "⚠️  " << symbol << " history incomplete - not publishing a mapped bar file" << std::endl;
+                continue;
+            }
+            
+            // Publish for other processes, then run off the mapping like they will
+            std::string path = quantlab::data::MappedBarFile::path_for(directory, symbol, "1Day");
+            if (quantlab::data::MappedBarFile::write(path, symbol, "1Day", first_day, today, history.owned.view())) {
+                if (auto mapped = quantlab::data::MappedBarFile::open(path)) {
+                    history.mapped = std::move(mapped);
+                    history.owned = quantlab::core::BarColumns();  // Release the heap copy
+                }
+            }
+        }
+    }
+    
+    // The trailing `days` calendar-day window of a preloaded symbol history (no copy)
+    quantlab::core::BarColumnsView window_for(const ParameterSet& params) const {
+        auto it = symbol_bars_.find(params.symbol);
+        if (it == symbol_bars_.end()) return {};
+        
+        auto bars = it->second.view();
+        int64_t window_start_ns = static_cast<int64_t>(
+            quantlab::data::AlpacaClient::aggregated_window_first_day(params.days)) * quantlab::core::NANOS_PER_DAY;
+        auto first = std::lower_bound(bars.timestamp_ns.begin(), bars.timestamp_ns.end(), window_start_ns);
+        return bars.subview(static_cast<size_t>(first - bars.timestamp_ns.begin()));
+    }
+    
+    // Highest-return result that actually ran; null if all failed
+    static const OptimizationResult* best_result(const std::vector<OptimizationResult>& results) {
+        const OptimizationResult* best = nullptr;
+        for (const auto& result : results) {
+            if (!result.failed && (!best || result.total_return > best->total_return)) best = &result;
+        }
+        return best;
+    }
+    
+    // Copy a finished engine's metrics (marked at final_price) into the result
+    static void record_metrics(OptimizationResult& result, const quantlab::backtest::BacktestEngine& engine,
+                               double final_price) {
+        // Extract performance metrics
+        const auto& portfolio = engine.get_portfolio();
+        const auto& metrics = engine.get_metrics();
+        
+        result.total_return = ((portfolio.cash + portfolio.shares_held * final_price) - 1000000.0) / 1000000.0;
+        result.total_trades = portfolio.trade_history.size();
+        result.winning_trades = metrics.winning_trades;
+        result.win_rate = metrics.win_rate_pct;
+        result.profit_factor = metrics.profit_factor;
+        result.max_drawdown = metrics.max_drawdown_pct;
+        result.sharpe_ratio = metrics.sharpe_ratio;
+        result.bars_evaluated = engine.accumulator().marks();
     }
     
     // Run backtest for single parameter set
@@ -135,157 +447,157 @@ public:
         
         try {
             // Initialize strategy with parameters
-            quantlab::strategy::MeanReversionStrategy strategy(client_);
+            quantlab::strategy::MeanReversionStrategy strategy(params.ema_period, params.rsi_period, params.bb_period,
+                                                               2.0, client_.get(),
+                                                               params.rsi_oversold, params.rsi_overbought);
             strategy.set_confidence_threshold(params.confidence_threshold);
             
-            // Load historical data (suppress output for cleaner optimization logs)
-            strategy.load_aggregated_historical_data(params.symbol, "1Day", params.days, 1);
-            
-            // Run backtest
-            auto trade_signals = strategy.backtest();
+            // Backtest on a view of the shared history; fall back to a direct load if it was never preloaded
+            if (symbol_bars_.count(params.symbol)) {
+                strategy.use_historical_data(window_for(params));
+            } else {
+                strategy.load_aggregated_historical_data(params.symbol, "1Day", params.days, 1);
+            }
             
             // Initialize backtesting engine
             quantlab::backtest::BacktestEngine engine(1000000.0); // $1M starting capital
             
-            // Execute trades and collect metrics
-            int buy_signals = 0, sell_signals = 0;
-            
-            for (const auto& signal_result : trade_signals) {
-                if (signal_result.signal == quantlab::strategy::Signal::BUY) buy_signals++;
-                else if (signal_result.signal == quantlab::strategy::Signal::SELL) sell_signals++;
-                
-                // Execute trades with configured confidence threshold
-                if (signal_result.signal == quantlab::strategy::Signal::BUY && 
-                    signal_result.confidence >= params.confidence_threshold) {
-                    
-                    int shares = static_cast<int>(50000 / signal_result.current_price);
-                    engine.get_portfolio().execute_buy(signal_result.current_price, shares, 
-                                                     signal_result.confidence, signal_result.reason);
-                }
-                else if (signal_result.signal == quantlab::strategy::Signal::SELL && 
-                         signal_result.confidence >= params.confidence_threshold) {
-                    
-                    if (engine.get_portfolio().shares_held > 0) {
-                        int shares_to_sell = static_cast<int>(50000 / signal_result.current_price);
-                        int shares = std::min(shares_to_sell, engine.get_portfolio().shares_held);
-                        engine.get_portfolio().execute_sell(signal_result.current_price, shares,
-                                                           signal_result.confidence, signal_result.reason);
-                    }
-                }
+            if (strategy.bars().empty()) {
+                std::cerr << "❌ Error testing " << params.symbol << " " << params.days << " days: no bars loaded"
+                          << std::endl;
+                result.failed = true;
+                return result;
             }
             
-            // Calculate final metrics
-            double final_price = trade_signals.empty() ? 100.0 : trade_signals.front().current_price;
-            engine.calculate_final_metrics(final_price);
-            
-            // Extract performance metrics
-            const auto& portfolio = engine.get_portfolio();
-            const auto& metrics = engine.get_metrics();
-            
-            result.total_return = ((portfolio.cash + portfolio.shares_held * final_price) - 1000000.0) / 1000000.0;
-            result.total_trades = portfolio.trade_history.size();
-            result.winning_trades = metrics.winning_trades;
-            result.win_rate = metrics.win_rate_pct;
-            result.profit_factor = metrics.profit_factor;
-            result.max_drawdown = metrics.max_drawdown_pct;
-            result.sharpe_ratio = metrics.sharpe_ratio;
+            // Shared event loop; metrics are marked at the last bar's close (100.0 if nothing was backtested)
+            double final_price = quantlab::backtest::run_strategy_backtest(strategy, engine,
+                                                                           params.confidence_threshold, 100.0);
+            record_metrics(result, engine, final_price);
             
         } catch (const std::exception& e) {
             std::cerr << "❌ Error testing " << params.symbol << " " << params.days 
                       << " days, " << (params.confidence_threshold * 100) << "% confidence: " 
                       << e.what() << std::endl;
+            result.failed = true;
         }
         
         return result;
     }
     
-    // Export results to CSV file
-    void export_to_csv(const std::string& filename) {
-        std::ofstream file(filename);
+    // Backtest every grid point of one preloaded (symbol, days) window in a single pass over its bars.
+    // One IndicatorBank updates all requested EMA/RSI/BB periods per bar; each grid point keeps its own
+    // strategy thresholds and engine. Results match run_single_backtest() for the same parameters.
+    // With a pruning policy, stopped lanes drop out of the loop; the pass ends when none are left.
+    void run_parameter_batch(const std::vector<size_t>& grid_indices) {
+        const ParameterSet& window_params = parameter_grid_[grid_indices.front()];
         
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Could not open " << filename << " for writing" << std::endl;
-            return;
+        try {
+            auto window = window_for(window_params);
+            if (window.empty()) throw std::runtime_error("no bars loaded");  // The symbol's load failed
+            std::span<const double> closes = window.close;
+            
+            std::vector<int> ema_periods, rsi_periods, bb_periods;
+            for (size_t i : grid_indices) {
+                ema_periods.push_back(parameter_grid_[i].ema_period);
+                rsi_periods.push_back(parameter_grid_[i].rsi_period);
+                bb_periods.push_back(parameter_grid_[i].bb_period);
+            }
+            quantlab::indicators::IndicatorBank bank(ema_periods, rsi_periods, bb_periods, 2.0);
+            
+            struct Lane {
+                size_t grid_index;
+                quantlab::strategy::MeanReversionStrategy strategy;
+                quantlab::backtest::BacktestEngine engine;
+                size_t ema_lane;
+                size_t rsi_lane;
+                size_t bb_lane;
+                bool pruned;
+                double stop_price;  // Close of the bar a pruned lane stopped on
+            };
+            std::vector<Lane> lanes;
+            lanes.reserve(grid_indices.size());
+            for (size_t i : grid_indices) {
+                const auto& params = parameter_grid_[i];
+                quantlab::strategy::MeanReversionStrategy strategy(params.ema_period, params.rsi_period, params.bb_period,
+                                                                   2.0, client_.get(),
+                                                                   params.rsi_oversold, params.rsi_overbought);
+                strategy.set_confidence_threshold(params.confidence_threshold);
+                lanes.push_back({i, std::move(strategy), quantlab::backtest::BacktestEngine(1000000.0),
+                                 bank.ema_index(params.ema_period), bank.rsi_index(params.rsi_period),
+                                 bank.bb_index(params.bb_period), false, 0.0});
+            }
+            std::vector<size_t> alive(lanes.size());  // Lanes still running, in grid order
+            for (size_t l = 0; l < lanes.size(); ++l) alive[l] = l;
+            
+            // Same warm-up as MeanReversionStrategy::backtest(), then every lane trades each bar
+            const size_t warmup = quantlab::strategy::MeanReversionStrategy::warmup_bars(closes.size());
+            const size_t bars_total = closes.size() > warmup ? closes.size() - warmup : 0;
+            QUANTLAB_PROFILE_SCOPE(SIGNALS);
+            for (size_t bar = 0; bar < closes.size() && !alive.empty(); ++bar) {
+                {
+                    QUANTLAB_PROFILE_HOT_SCOPE(INDICATORS);
+                    bank.update(closes[bar]);
+                }
+                if (bar < warmup) continue;
+                
+                const auto market = quantlab::backtest::market_event(window, bar);
+                for (size_t l : alive) {
+                    auto& lane = lanes[l];
+                    auto signal_result = lane.strategy.evaluate(closes[bar], bank.ema(lane.ema_lane),
+                                                                bank.rsi(lane.rsi_lane), bank.bands(lane.bb_lane));
+                    signal_result.timestamp_ns = window.timestamp_ns[bar];
+                    QUANTLAB_PROFILE_HOT_SCOPE(EXECUTION);
+                    lane.engine.on_bar(market);
+                    quantlab::backtest::route_signal(lane.engine, signal_result,
+                                                     parameter_grid_[lane.grid_index].confidence_threshold);
+                }
+                QUANTLAB_PROFILE_COUNT(BARS_BACKTESTED, alive.size());
+                
+                if (pruning_) prune_lanes(*pruning_, lanes, alive, TrialProgress{bar + 1 - warmup, bars_total},
+                                          closes[bar]);
+            }
+            
+            // Same final price as run_single_backtest(): the last bar's close. Pruned lanes keep the
+            // metrics they had when stopped, so they are marked at their stop bar's close instead.
+            double final_price = closes.size() > warmup ? closes.back() : 100.0;
+            for (auto& lane : lanes) {
+                OptimizationResult result(parameter_grid_[lane.grid_index]);
+                double mark_price = lane.pruned ? lane.stop_price : final_price;
+                lane.engine.calculate_final_metrics(mark_price);
+                record_metrics(result, lane.engine, mark_price);
+                result.pruned = lane.pruned;
+                results_[lane.grid_index] = result;
+            }
+            
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Error testing " << window_params.symbol << " " << window_params.days 
+                      << " days: " << e.what() << std::endl;
+            for (size_t i : grid_indices) {
+                results_[i] = OptimizationResult(parameter_grid_[i]);
+                results_[i].failed = true;
+            }
         }
-        
-        // CSV header
-        file << "Symbol,Days,Confidence_Threshold,Total_Return,Max_Drawdown,Sharpe_Ratio,"
-             << "Total_Trades,Winning_Trades,Win_Rate,Profit_Factor\n";
-        
-        // Data rows
-        for (const auto& result : results_) {
-            file << result.parameters.symbol << ","
-                 << result.parameters.days << ","
-                 << std::fixed << std::setprecision(3) << result.parameters.confidence_threshold << ","
-                 << std::fixed << std::setprecision(4) << result.total_return << ","
-                 << std::fixed << std::setprecision(4) << result.max_drawdown << ","
-                 << std::fixed << std::setprecision(4) << result.sharpe_ratio << ","
-                 << result.total_trades << ","
-                 << result.winning_trades << ","
-                 << std::fixed << std::setprecision(2) << result.win_rate << ","
-                 << std::fixed << std::setprecision(2) << result.profit_factor << "\n";
+    }
+    
+    // Export results to CSV file
+    void export_to_csv(const std::string& filename) {
+        if (write_results_csv(filename, results_)) {
+            std::cout << "📄 Results exported to " << filename << std::endl;
         }
-        
-        file.close();
-        std::cout << "📄 Results exported to " << filename << std::endl;
     }
     
     // Export results to JSON file (web-friendly)
     void export_to_json(const std::string& filename) {
-        std::ofstream file(filename);
-        
-        if (!file.is_open()) {
-            std::cerr << "❌ Error: Could not open " << filename << " for writing" << std::endl;
-            return;
+        if (write_results_json(filename, results_)) {
+            std::cout << "📄 Web-friendly JSON results exported to " << filename << std::endl;
+        }
+    }
+    
+    // Export results to the binary columnar format (see result_export.hpp), loadable without parsing
+    void export_to_binary(const std::string& filename) {
+        if (write_results_binary(filename, results_)) {
+            std::cout << "📄 Columnar binary results exported to " << filename << std::endl;
         }
-        
-        file << "{\n";
-        file << "  \"optimization_results\": [\n";
-        
-        for (size_t i = 0; i < results_.size(); ++i) {
-            const auto& result = results_[i];
-            file << "    {\n";
-            file << "      \"symbol\": \"" << result.parameters.symbol << "\",\n";
-            file << "      \"days\": " << result.parameters.days << ",\n";
-            file << "      \"confidence_threshold\": " << std::fixed << std::setprecision(3) << result.parameters.confidence_threshold << ",\n";
-            file << "      \"total_return\": " << std::fixed << std::setprecision(4) << result.total_return << ",\n";
-            file << "      \"total_return_pct\": " << std::fixed << std::setprecision(2) << (result.total_return * 100) << ",\n";
-            file << "      \"max_drawdown\": " << std::fixed << std::setprecision(4) << result.max_drawdown << ",\n";
-            file << "      \"sharpe_ratio\": " << std::fixed << std::setprecision(4) << result.sharpe_ratio << ",\n";
-            file << "      \"total_trades\": " << result.total_trades << ",\n";
-            file << "      \"winning_trades\": " << result.winning_trades << ",\n";
-            file << "      \"win_rate\": " << std::fixed << std::setprecision(2) << result.win_rate << ",\n";
-            file << "      \"profit_factor\": " << std::fixed << std::setprecision(2) << result.profit_factor << "\n";
-            file << "    }";
-            if (i < results_.size() - 1) file << ",";
-            file << "\n";
-        }
-        
-        file << "  ],\n";
-        file << "  \"summary\": {\n";
-        file << "    \"total_combinations\": " << results_.size() << ",\n";
-        file << "    \"symbols_tested\": [";
-        
-        // Get unique symbols
-        std::set<std::string> unique_symbols;
-        for (const auto& result : results_) {
-            unique_symbols.insert(result.parameters.symbol);
-        }
-        
-        auto it = unique_symbols.begin();
-        for (size_t i = 0; i < unique_symbols.size(); ++i) {
-            file << "\"" << *it << "\"";
-            if (i < unique_symbols.size() - 1) file << ", ";
-            ++it;
-        }
-        
-        file << "],\n";
-        file << "    \"date_generated\": \"" << __DATE__ << "\"\n";
-        file << "  }\n";
-        file << "}\n";
-        
-        file.close();
-        std::cout << "📄 Web-friendly JSON results exported to " << filename << std::endl;
     }
     
     // Print top performing parameter combinations
@@ -295,8 +607,16 @@ public:
             return;
         }
         
-        // Sort by total return (descending)
-        auto sorted_results = results_;
+        // Sort by total return (descending); failed backtests have nothing to rank
+        std::vector<OptimizationResult> sorted_results;
+        std::copy_if(results_.begin(), results_.end(), std::back_inserter(sorted_results),
+                     [](const OptimizationResult& r) { return !r.failed; });
+        size_t failed = results_.size() - sorted_results.size();
+        if (failed > 0) {
+            std::cout << "⚠️  " << failed << " of " << results_.size() << " backtests failed and are not ranked"
+                      << std::endl;
+        }
+        if (sorted_results.empty()) return;
         std::sort(sorted_results.begin(), sorted_results.end(),
                   [](const OptimizationResult& a, const OptimizationResult& b) {
                       return a.total_return > b.total_return;
@@ -330,45 +650,340 @@ public:
         std::cout << std::string(100, '=') << std::endl;
     }
     
+    // Backtest an explicit list of parameter sets without progress output; results are in grid order.
+    // Loaded histories are kept between calls, so a long-lived optimizer only downloads a symbol once a day.
+    const std::vector<OptimizationResult>& evaluate(std::vector<ParameterSet> grid) {
+        parameter_grid_ = std::move(grid);
+        evaluate_grid(false);
+        return results_;
+    }
+    
     // Get optimization results
     const std::vector<OptimizationResult>& get_results() const {
         return results_;
     }
 };
 
+/**
+ * --serve mode: JSON-RPC 2.0 over a Unix socket, one request / response per line
+ *
+ * Methods:
+ *   ping      -> {"pong": true}
+ *   optimize  {symbol, days, confidence_threshold, oversold_threshold, overbought_threshold,
+ *              rsi_period_min, rsi_period_max, ema_period, bb_period}
+ *             -> {"optimization_results": [...best first], "summary": {...}}; runs whose backtest
+ *                failed are flagged "failed" and listed last, error -32000 if every run failed
+ *   stats     -> {"requests", "workers", "uptime_seconds", "cache": {"entries", "hits", "misses"}}
+ *
+ * Every worker owns a StrategyOptimizer whose symbol histories stay loaded between
+ * requests (memory-mapped from the shared bar files), so only the first request for a
+ * symbol on a given day pays for the download, and repeated requests are answered from
+ * the shared result cache until new bars arrive. optimize results use the same fields as
+ * institutional_backtest's JSON, which the dashboard already reads.
+ */
+class OptimizerService {
+private:
+    static constexpr int MAX_RSI_PERIODS = 64;  // Bound on one request's grid
+    static constexpr size_t MAX_SYMBOL_LENGTH = 15;
+    
+    std::vector<std::unique_ptr<StrategyOptimizer>> optimizers_;  // One per worker
+    std::shared_ptr<ResultCache> cache_;                          // Shared by all workers (may be null)
+    std::atomic<size_t> requests_{0};
+    std::chrono::steady_clock::time_point started_ = std::chrono::steady_clock::now();
+    
+    struct RpcError {
+        int code;
+        std::string message;
+    };
+    
+    static nlohmann::json error_response(const nlohmann::json& id, int code, const std::string& message) {
+        return {{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}};
+    }
+    
+    static int int_param(const nlohmann::json& params, const char* name, int fallback, int min, int max) {
+        if (!params.contains(name)) return fallback;
+        const auto& value = params[name];
+        if (!value.is_number()) throw RpcError{-32602, std::string(name) + " must be a number"};
+        double number = value.get<double>();
+        if (number < min || number > max) {
+            throw RpcError{-32602, std::string(name) + " must be in [" + std::to_string(min) + ", " +
+                                   std::to_string(max) + "]"};
+        }
+        return static_cast<int>(number);
+    }
+    
+    // Upper-cased ticker matching [A-Z0-9.]{1,15}: it becomes part of cache file paths and
+    // API URLs, so nothing else gets through (15 is also what a mapped file header holds)
+    static std::string symbol_param(const nlohmann::json& params) {
+        if (!params.contains("symbol")) return "AAPL";
+        const auto& value = params["symbol"];
+        if (!value.is_string()) throw RpcError{-32602, "symbol must be a string"};
+        std::string symbol = value.get<std::string>();
+        bool valid = !symbol.empty() && symbol.size() <= MAX_SYMBOL_LENGTH;
+        for (char& c : symbol) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            valid = valid && ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.');
+        }
+        if (!valid) {
+            throw RpcError{-32602, "symbol must be 1-" + std::to_string(MAX_SYMBOL_LENGTH) +
+                                   " characters of A-Z, 0-9 and '.'"};
+        }
+        return symbol;
+    }
+    
+    nlohmann::json optimize(StrategyOptimizer& optimizer, const nlohmann::json& params) const {
+        auto start_time = std::chrono::steady_clock::now();
+        
+        std::string symbol = symbol_param(params);
+        int days = int_param(params, "days", 120, 1, 3650);
+        int oversold = int_param(params, "oversold_threshold", 30, 0, 100);
+        int overbought = int_param(params, "overbought_threshold", 70, 0, 100);
+        int rsi_min = int_param(params, "rsi_period_min", 14, 2, 500);
+        int rsi_max = int_param(params, "rsi_period_max", rsi_min, 2, 500);
+        int ema_period = int_param(params, "ema_period", 20, 1, 500);
+        int bb_period = int_param(params, "bb_period", 20, 2, 500);
+        if (rsi_max < rsi_min) std::swap(rsi_min, rsi_max);
+        if (rsi_max - rsi_min + 1 > MAX_RSI_PERIODS) {
+            throw RpcError{-32602, "at most " + std::to_string(MAX_RSI_PERIODS) + " RSI periods per request"};
+        }
+        
+        // Fraction, or a percentage as the dashboard sends it (65 = 0.65)
+        double confidence = 0.65;
+        if (params.contains("confidence_threshold")) {
+            const auto& value = params["confidence_threshold"];
+            if (!value.is_number()) throw RpcError{-32602, "confidence_threshold must be a number"};
+            confidence = value.get<double>();
+        }
+        if (confidence > 1.0) confidence /= 100.0;
+        if (confidence <= 0.0 || confidence > 1.0) throw RpcError{-32602, "confidence_threshold must be in (0, 1]"};
+        
+        std::vector<ParameterSet> grid;
+        for (int rsi = rsi_min; rsi <= rsi_max; ++rsi) {
+            grid.emplace_back(symbol, days, confidence, ema_period, rsi, bb_period, oversold, overbought);
+        }
+        std::vector<OptimizationResult> results = optimizer.evaluate(std::move(grid));
+        size_t failed = std::count_if(results.begin(), results.end(), [](const OptimizationResult& r) { return r.failed; });
+        if (failed == results.size()) {
+            throw RpcError{-32000, "backtest failed for " + symbol + " (no market data?)"};
+        }
+        
+        // Best first; failed runs (flagged, all-zero metrics) go last and are left out of the summary
+        std::stable_sort(results.begin(), results.end(), [](const OptimizationResult& a, const OptimizationResult& b) {
+            if (a.failed != b.failed) return b.failed;
+            return a.total_return > b.total_return;
+        });
+        
+        nlohmann::json rows = nlohmann::json::array();
+        int total_trades = 0;
+        for (const auto& result : results) {
+            const auto& p = result.parameters;
+            rows.push_back({
+                {"symbol", p.symbol},
+                {"days", p.days},
+                {"confidence_threshold", p.confidence_threshold},
+                {"ema_period", p.ema_period},
+                {"rsi_period", p.rsi_period},
+                {"bb_period", p.bb_period},
+                {"rsi_period_min", rsi_min},
+                {"rsi_period_max", rsi_max},
+                {"oversold_threshold", p.rsi_oversold},
+                {"overbought_threshold", p.rsi_overbought},
+                {"total_return", result.total_return},
+                {"total_return_pct", result.total_return * 100},
+                {"max_drawdown", -result.max_drawdown / 100.0},
+                {"sharpe_ratio", result.sharpe_ratio},
+                {"total_trades", result.total_trades},
+                {"winning_trades", result.winning_trades},
+                {"win_rate", result.win_rate},
+                {"profit_factor", result.profit_factor},
+                {"failed", result.failed}
+            });
+            total_trades += result.total_trades;
+        }
+        const size_t succeeded = results.size() - failed;
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+        return {
+            {"success", true},
+            {"optimization_results", std::move(rows)},
+            {"summary", {
+                {"total_combinations", results.size()},
+                {"failed_runs", failed},
+                {"best_return", results.front().total_return},
+                {"avg_trades", total_trades / static_cast<int>(succeeded)},
+                {"elapsed_ms", elapsed.count() / 1000.0}
+            }}
+        };
+    }
+    
+public:
+    OptimizerService(std::shared_ptr<quantlab::data::DataSource> client, size_t workers,
+                     std::shared_ptr<ResultCache> cache = nullptr)
+        : cache_(std::move(cache)) {
+        // Split the cores between the workers; each request still backtests its grid in parallel
+        size_t threads_per_worker = std::max<size_t>(1, quantlab::core::default_thread_count() / std::max<size_t>(1, workers));
+        for (size_t i = 0; i < std::max<size_t>(1, workers); ++i) {
+            optimizers_.push_back(std::make_unique<StrategyOptimizer>(client));
+            optimizers_.back()->set_thread_count(threads_per_worker);
+            optimizers_.back()->set_result_cache(cache_);
+        }
+    }
+    
+    size_t worker_count() const { return optimizers_.size(); }
+    
+    // One request line in, one response line out; never throws
+    std::string handle(size_t worker, const std::string& line) {
+        ++requests_;
+        nlohmann::json request = nlohmann::json::parse(line, nullptr, false);
+        if (request.is_discarded() || !request.is_object()) {
+            return error_response(nullptr, -32700, "Parse error").dump();
+        }
+        nlohmann::json id = request.value("id", nlohmann::json());
+        if (!request.contains("method") || !request["method"].is_string()) {
+            return error_response(id, -32600, "Invalid request: method missing").dump();
+        }
+        
+        const std::string method = request["method"];
+        const nlohmann::json params = request.value("params", nlohmann::json::object());
+        try {
+            nlohmann::json result;
+            if (method == "ping") {
+                result = {{"pong", true}};
+            } else if (method == "optimize") {
+                result = optimize(*optimizers_[worker], params);
+            } else if (method == "stats") {
+                auto uptime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - started_);
+                result = {{"requests", requests_.load()}, {"workers", optimizers_.size()},
+                          {"uptime_seconds", uptime.count()}};
+                if (cache_) {
+                    result["cache"] = {{"entries", cache_->size()}, {"hits", cache_->hits()},
+                                       {"misses", cache_->misses()}};
+                }
+            } else {
+                return error_response(id, -32601, "Method not found: " + method).dump();
+            }
+            return nlohmann::json{{"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}}.dump();
+        } catch (const RpcError& e) {
+            return error_response(id, e.code, e.message).dump();
+        } catch (const std::exception& e) {
+            return error_response(id, -32603, e.what()).dump();
+        }
+    }
+};
+
 } // namespace quantlab::optimization
 
+namespace {
+
+quantlab::core::UnixLineServer* active_server = nullptr;
+
+// SIGINT / SIGTERM: stop accepting, answer what is queued, exit
+void stop_active_server(int) {
+    if (active_server) active_server->stop();
+}
+
+// Results persist next to the bars they were computed from; empty if the bar cache is off
+std::string result_cache_path(const quantlab::data::DataSource& client) {
+    const auto* cache = client.bar_cache();
+    return cache ? cache->directory() + "/optimizer_results.qlrc" : std::string();
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
+    quantlab::core::profiling::Session profiling_session;  // QUANTLAB_PROFILE=1 / QUANTLAB_TRACE=<file>
     try {
         std::cout << "🎯 QUANTLAB STRATEGY OPTIMIZER" << std::endl;
         std::cout << "Automated Parameter Sweep Framework\n" << std::endl;
         
-        // Initialize API client
-        auto client = std::make_shared<quantlab::data::AlpacaClient>();
+        // Initialize API client (QUANTLAB_DATA_SOURCE=synthetic runs offline)
+        auto client = quantlab::data::make_data_source_from_env();
         client->test_connection();
         
+        auto result_cache = std::make_shared<quantlab::optimization::ResultCache>();
+        const std::string result_cache_file = result_cache_path(*client);
+        if (!result_cache_file.empty() && result_cache->load(result_cache_file)) {
+            std::cout << "♻️  Loaded " << result_cache->size() << " cached results from " << result_cache_file << std::endl;
+        }
+        auto save_result_cache = [&] {
+            if (!result_cache_file.empty() && result_cache->size() > 0) result_cache->save(result_cache_file);
+        };
+        
+        if (argc > 1 && std::string(argv[1]) == "--serve") {
+            // --serve [socket_path] [workers]: long-lived JSON-RPC service (see OptimizerService)
+            std::string socket_path = argc > 2 ? argv[2] : "/tmp/quantlab_optimizer.sock";
+            size_t workers = argc > 3 ? static_cast<size_t>(std::max(1, std::atoi(argv[3]))) : 4;
+            
+            quantlab::optimization::OptimizerService service(client, workers, result_cache);
+            quantlab::core::UnixLineServer server(socket_path, service.worker_count(),
+                                                  [&service](size_t worker, const std::string& request) {
+                                                      return service.handle(worker, request);
+                                                  });
+            active_server = &server;
+            std::signal(SIGINT, stop_active_server);
+            std::signal(SIGTERM, stop_active_server);
+            
+            std::cout << "🛰️  Serving JSON-RPC on " << socket_path << " with " << workers << " workers" << std::endl;
+            bool ok = server.run();
+            active_server = nullptr;
+            save_result_cache();
+            std::cout << "👋 Optimizer service stopped" << std::endl;
+            return ok ? 0 : 1;
+        }
+        
         // Initialize optimizer
         quantlab::optimization::StrategyOptimizer optimizer(client);
+        optimizer.set_result_cache(result_cache);
         
         // Define focused parameter ranges for web-friendly testing
         std::vector<std::string> symbols = {"AAPL"};  // Focus on 1 symbol for validation
         std::vector<int> days_range = {60, 120, 365};         // 3 meaningful time periods
         std::vector<double> confidence_range = {0.5, 0.65, 0.8}; // 3 confidence levels
         
-        // Build parameter grid (1 * 3 * 3 = 9 combinations)
-        optimizer.build_parameter_grid(symbols, days_range, confidence_range);
+        if (argc > 1 && std::string(argv[1]) == "--walk-forward") {
+            // --walk-forward [rolling|anchored|kfold] [folds]: out-of-sample check of an indicator grid
+            quantlab::optimization::ValidationConfig config;
+            std::string mode = argc > 2 ? argv[2] : "rolling";
+            if (mode == "anchored") config.mode = quantlab::optimization::ValidationMode::WALK_FORWARD_ANCHORED;
+            else if (mode == "kfold") config.mode = quantlab::optimization::ValidationMode::K_FOLD;
+            if (argc > 3) config.folds = static_cast<size_t>(std::max(2, std::atoi(argv[3])));
+            
+            optimizer.build_parameter_grid(symbols, {365}, confidence_range, {10, 20, 50}, {7, 14}, {10, 20});
+            auto report = optimizer.run_walk_forward(symbols.front(), 365, config);
+            optimizer.print_validation_report(report);
+            return 0;
+        }
         
-        // Run optimization
-        optimizer.run_optimization();
+        if (argc > 2 && std::string(argv[1]) == "--search") {
+            // --search <random|lhs|tpe|coordinate> [budget]: sample indicator periods and RSI levels too
+            quantlab::optimization::SearchSpace space(symbols, days_range);
+            size_t budget = argc > 3 ? static_cast<size_t>(std::max(1, std::atoi(argv[3]))) : 64;
+            
+            auto driver = quantlab::optimization::make_search_driver(argv[2], space, budget);
+            if (!driver) {
+                std::cerr << "❌ Unknown search driver '" << argv[2] << "' (use random, lhs, tpe or coordinate)" << std::endl;
+                return 1;
+            }
+            optimizer.run_search(*driver);
+        } else {
+            // Build parameter grid (1 * 3 * 3 = 9 combinations)
+            optimizer.build_parameter_grid(symbols, days_range, confidence_range);
+            
+            // Run optimization
+            optimizer.run_optimization();
+        }
+        save_result_cache();
         
         // Display top results
         optimizer.print_top_results(10);
         
-        // Export to both CSV and JSON
+        // Export to CSV, JSON and the binary columnar format
         std::string csv_filename = "optimization_results.csv";
         std::string json_filename = "optimization_results.json";
+        std::string binary_filename = "optimization_results.qlr";
         optimizer.export_to_csv(csv_filename);
         optimizer.export_to_json(json_filename);
+        optimizer.export_to_binary(binary_filename);
         
         std::cout << "\n✅ Strategy optimization completed successfully!" << std::endl;
         std::cout << "📊 Data available in CSV format for analysis and JSON format for web integration" << std::endl;
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include "../src/data/alpaca_client.hpp"
+#include "../src/backtest/strategy_runner.hpp"
+#include "../src/core/time_utils.hpp"
+#include "../src/core/profiler.hpp"
+
+// Intraday mean-reversion backtest on trade ticks: one day of trades is paged in, every page
+// streams through a TickBacktest, and bars are aggregated on the fly (time or volume bars).
+// Memory stays at one page of ticks plus the bar in progress, whatever the day's trade count.
+//
+// Usage: tick_backtest [SYMBOL] [DATE] [time|volume] [SIZE] [CONFIDENCE]
+//   SIZE = minutes per bar (time, default 1) or shares per bar (volume, default 50000)
+int main(int argc, char* argv[]) {
+    quantlab::core::profiling::Session profiling_session;  // QUANTLAB_PROFILE=1 / QUANTLAB_TRACE=<file>
+    std::string symbol = argc > 1 ? argv[1] : "AAPL";
+    std::transform(symbol.begin(), symbol.end(), symbol.begin(), ::toupper);
+    // Default: the newest day the historical endpoints serve (see HISTORY_LAG_DAYS)
+    std::string date = argc > 2 ? argv[2] : quantlab::core::date_from_epoch_day(
+        quantlab::core::today_epoch_day() - quantlab::data::AlpacaClient::HISTORY_LAG_DAYS);
+    std::string mode = argc > 3 ? argv[3] : "time";
+    long size = argc > 4 ? std::atol(argv[4]) : 0;
+    double confidence_threshold = argc > 5 ? std::atof(argv[5]) : 0.65;
+    if (confidence_threshold <= 0.0 || confidence_threshold > 1.0) confidence_threshold = 0.65;
+
+    auto aggregator = mode == "volume"
+        ? quantlab::core::BarAggregator::volume_bars(size > 0 ? size : 50000)
+        : quantlab::core::BarAggregator::minute_bars(size > 0 ? static_cast<int>(size) : 1);
+    std::string bar_label = mode == "volume"
+        ? std::to_string(aggregator.size()) + "-share bars"
+        : std::to_string(aggregator.size() / (60 * quantlab::core::NANOS_PER_SECOND)) + "-minute bars";
+
+    try {
+        auto client = std::make_shared<quantlab::data::AlpacaClient>();
+        quantlab::strategy::MeanReversionStrategy strategy(client);
+        strategy.set_confidence_threshold(confidence_threshold);
+        quantlab::backtest::BacktestEngine engine(100000.0);
+        quantlab::backtest::TickBacktest backtest(strategy, engine, aggregator, confidence_threshold);
+
+        int32_t day = quantlab::core::epoch_day_from_date(date);
+        std::cout << "⏱️  Tick backtest: " << symbol << " trades on " << date << ", " << bar_label << std::endl;
+
+        auto start_time = std::chrono::steady_clock::now();
+        const int64_t day_start_ns = static_cast<int64_t>(day) * quantlab::core::NANOS_PER_DAY;
+        auto delivered = client->for_each_trade_page(
+            symbol, quantlab::core::format_iso8601(day_start_ns),
+            quantlab::core::format_iso8601(day_start_ns + quantlab::core::NANOS_PER_DAY),
+            [&backtest](std::span<const quantlab::core::Tick> ticks) { backtest.on_ticks(ticks); });
+        if (!delivered.has_value()) {
+            std::cerr << "❌ Error: Could not download trades for " << symbol << " on " << date << std::endl;
+            return 1;
+        }
+        double final_price = backtest.finish();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        if (backtest.ticks() == 0) {
+            std::cout << "No trades for " << symbol << " on " << date << " (market closed?)" << std::endl;
+            return 0;
+        }
+
+        std::cout << "📈 " << backtest.ticks() << " ticks -> " << backtest.bars() << " bars in "
+                  << std::fixed << std::setprecision(2) << seconds << " s ("
+                  << std::setprecision(0) << backtest.ticks() / std::max(seconds, 1e-9) << " ticks/s), last price "
+                  << std::setprecision(2) << final_price << std::endl;
+        engine.print_results();
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <iostream>
+#include "../src/core/data_types.hpp"
+#include "../src/data/synthetic_data.hpp"
+
+namespace quantlab::bench {
+
+// One series per size, generated on first use and shared by every benchmark in the binary
+inline const quantlab::core::BarColumns& shared_gbm_bars(size_t count) {
+    static std::map<size_t, quantlab::core::BarColumns> series;
+    auto it = series.find(count);
+    if (it == series.end()) it = series.emplace(count, quantlab::data::driftless_gbm_bars(count)).first;
+    return it->second;
+}
+
+// Report throughput as a "bars/s" counter (units per wall second, comparable across benchmarks and commits)
+inline void set_bar_rate(benchmark::State& state, size_t bars_per_iteration) {
+    state.counters["bars/s"] = benchmark::Counter(static_cast<double>(bars_per_iteration),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Discards std::cout while alive (the strategy prints a line per backtest)
+class QuietStdout {
+public:
+    QuietStdout() : saved_(std::cout.rdbuf(nullptr)) {}
+    ~QuietStdout() {
+        std::cout.rdbuf(saved_);
+        std::cout.clear();
+    }
+    QuietStdout(const QuietStdout&) = delete;
+    QuietStdout& operator=(const QuietStdout&) = delete;
+
+private:
+    std::streambuf* saved_;
+};
+
+} // namespace quantlab::bench
@@ -0,0 +1,59 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "bench_common.hpp"
+#include "../src/optimization/result_export.hpp"
+
+// Optimizer result writers (CSV / JSON / binary .qlr) on state.range(0) rows, written to the temp directory
+namespace {
+
+std::vector<quantlab::optimization::OptimizationResult> make_results(size_t rows) {
+    const char* symbols[] = {"AAPL", "MSFT", "NVDA", "TSLA"};
+    std::vector<quantlab::optimization::OptimizationResult> results;
+    results.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        quantlab::optimization::ParameterSet params(symbols[i % 4], 365, 0.5 + 0.01 * (i % 40),
+                                                    10 + static_cast<int>(i % 30), 7 + static_cast<int>(i % 14),
+                                                    10 + static_cast<int>(i % 20));
+        quantlab::optimization::OptimizationResult result(params);
+        result.total_return = 0.001 * static_cast<double>(i % 997) - 0.3;
+        result.max_drawdown = 0.0001 * static_cast<double>(i % 1999);
+        result.sharpe_ratio = 0.01 * static_cast<double>(i % 301) - 1.0;
+        result.total_trades = static_cast<int>(i % 120);
+        result.winning_trades = result.total_trades / 2;
+        result.win_rate = 0.5;
+        result.profit_factor = 1.0 + 0.001 * static_cast<double>(i % 500);
+        result.bars_evaluated = 250;
+        results.push_back(result);
+    }
+    return results;
+}
+
+using ResultWriter = bool (*)(const std::string&, std::span<const quantlab::optimization::OptimizationResult>);
+
+void BM_Export(benchmark::State& state, ResultWriter write, const char* extension) {
+    const auto results = make_results(static_cast<size_t>(state.range(0)));
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              (std::string("quantlab_bench_results") + extension)).string();
+    for (auto _ : state) {
+        if (!write(path, results)) {
+            state.SkipWithError("export failed");
+            break;
+        }
+    }
+    std::error_code ec;
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(std::filesystem::file_size(path, ec)));
+    state.counters["rows/s"] = benchmark::Counter(static_cast<double>(results.size()),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+    std::filesystem::remove(path, ec);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_Export, csv, quantlab::optimization::write_results_csv, ".csv")
+    ->ArgName("rows")->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Export, json, quantlab::optimization::write_results_json, ".json")
+    ->ArgName("rows")->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Export, binary, quantlab::optimization::write_results_binary, ".qlr")
+    ->ArgName("rows")->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
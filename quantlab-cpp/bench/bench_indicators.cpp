@@ -0,0 +1,95 @@
+#include <span>
+#include <vector>
+#include "bench_common.hpp"
+#include "../src/indicators/rolling_ema.hpp"
+#include "../src/indicators/rsi.hpp"
+#include "../src/indicators/bollinger_bands.hpp"
+
+// Per-indicator throughput, streaming update() and batch compute(), over the usual periods
+// Every iteration runs one pass over a 65536-bar series; "bars/s" is the comparable figure.
+namespace {
+
+using quantlab::bench::shared_gbm_bars;
+using quantlab::bench::set_bar_rate;
+
+constexpr size_t SERIES_BARS = 1 << 16;
+
+std::span<const double> closes() {
+    return shared_gbm_bars(SERIES_BARS).view().close;
+}
+
+void BM_EmaUpdate(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::RollingEMA ema(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        ema.reset();
+        for (double price : prices) benchmark::DoNotOptimize(ema.update(price));
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void BM_RsiUpdate(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::RSI rsi(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        rsi.reset();
+        for (double price : prices) benchmark::DoNotOptimize(rsi.update(price));
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void BM_BollingerUpdate(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::BollingerBands bb(static_cast<int>(state.range(0)), 2.0);
+    for (auto _ : state) {
+        bb.reset();
+        for (double price : prices) benchmark::DoNotOptimize(bb.update(price));
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void BM_EmaCompute(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::RollingEMA ema(static_cast<int>(state.range(0)));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        ema.compute(prices, out);
+        benchmark::ClobberMemory();
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void BM_RsiCompute(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::RSI rsi(static_cast<int>(state.range(0)));
+    std::vector<double> out(prices.size());
+    for (auto _ : state) {
+        rsi.compute(prices, out);
+        benchmark::ClobberMemory();
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void BM_BollingerCompute(benchmark::State& state) {
+    auto prices = closes();
+    quantlab::indicators::BollingerBands bb(static_cast<int>(state.range(0)), 2.0);
+    std::vector<double> upper(prices.size()), middle(prices.size()), lower(prices.size());
+    for (auto _ : state) {
+        bb.compute(prices, upper, middle, lower);
+        benchmark::ClobberMemory();
+    }
+    set_bar_rate(state, prices.size());
+}
+
+void periods(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("period")->Arg(5)->Arg(14)->Arg(20)->Arg(50)->Arg(200);
+}
+
+} // namespace
+
+BENCHMARK(BM_EmaUpdate)->Apply(periods);
+BENCHMARK(BM_RsiUpdate)->Apply(periods);
+BENCHMARK(BM_BollingerUpdate)->Apply(periods);
+BENCHMARK(BM_EmaCompute)->Apply(periods);
+BENCHMARK(BM_RsiCompute)->Apply(periods);
+BENCHMARK(BM_BollingerCompute)->Apply(periods);
@@ -0,0 +1,61 @@
+#include <memory>
+#include "bench_common.hpp"
+#include "../src/backtest/backtest_engine.hpp"
+#include "../src/backtest/strategy_runner.hpp"
+
+// Execution paths: direct Portfolio::execute_buy/sell, and the engine's bar -> order -> fill loop
+namespace {
+
+using quantlab::bench::shared_gbm_bars;
+using quantlab::bench::set_bar_rate;
+
+constexpr size_t ENGINE_BARS = 100000;
+
+// Round trips of 100 shares; state.range(0) round trips per iteration on a fresh portfolio
+void BM_PortfolioExecute(benchmark::State& state) {
+    const size_t round_trips = static_cast<size_t>(state.range(0));
+    const quantlab::core::SignalReason reason{quantlab::core::ReasonCode::RSI_OVERSOLD, 25.0, 0.8, 0.65};
+    for (auto _ : state) {
+        quantlab::backtest::Portfolio portfolio;
+        for (size_t i = 0; i < round_trips; ++i) {
+            double price = 100.0 + static_cast<double>(i % 16);
+            portfolio.execute_buy(price, 100, 0.8, reason, static_cast<int64_t>(i));
+            portfolio.execute_sell(price + 1.0, 100, 0.8, reason, static_cast<int64_t>(i));
+        }
+        benchmark::DoNotOptimize(portfolio.cash);
+    }
+    state.counters["fills/s"] = benchmark::Counter(static_cast<double>(2 * round_trips),
+                                                   benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Engine fed every bar, alternating BUY / SELL signals every `state.range(1)` bars
+// range(0): 0 = fill at the signal bar's close, 1 = queue for the next bar's open
+void BM_EngineSignals(benchmark::State& state) {
+    const auto bars = shared_gbm_bars(ENGINE_BARS).view();
+    const auto timing = state.range(0) == 0 ? quantlab::backtest::FillTiming::BAR_CLOSE
+                                            : quantlab::backtest::FillTiming::NEXT_BAR_OPEN;
+    const size_t signal_every = static_cast<size_t>(state.range(1));
+    auto fill_model = std::make_shared<quantlab::backtest::SimpleFillModel>(timing, 2.0, 0.005, 1.0);
+    const quantlab::core::SignalReason reason{quantlab::core::ReasonCode::RSI_OVERSOLD, 25.0, 0.8, 0.65};
+    for (auto _ : state) {
+        quantlab::backtest::BacktestEngine engine(100000.0);
+        engine.set_fill_model(fill_model);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            engine.on_bar(quantlab::backtest::market_event(bars, i));
+            if (i % signal_every == 0) {
+                bool buy = (i / signal_every) % 2 == 0;
+                engine.on_signal(buy ? quantlab::core::TradeAction::BUY : quantlab::core::TradeAction::SELL,
+                                 0.8, reason);
+            }
+        }
+        engine.calculate_final_metrics(bars.close.back());
+        benchmark::DoNotOptimize(engine.get_metrics().sharpe_ratio);
+    }
+    set_bar_rate(state, bars.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_PortfolioExecute)->ArgName("round_trips")->Arg(1000)->Arg(100000);
+BENCHMARK(BM_EngineSignals)->ArgNames({"next_open", "signal_every"})
+    ->ArgsProduct({{0, 1}, {1, 10, 1000}})->Unit(benchmark::kMillisecond);
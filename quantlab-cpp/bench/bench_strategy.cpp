@@ -0,0 +1,63 @@
+#include <memory>
+#include "bench_common.hpp"
+#include "../src/strategy/mean_reversion_strategy.hpp"
+#include "../src/strategy/static_mean_reversion_strategy.hpp"
+#include "../src/backtest/strategy_runner.hpp"
+
+// Strategy backtests on synthetic GBM series of 1e4 - 1e7 bars (default parameters, no API client)
+namespace {
+
+using quantlab::bench::shared_gbm_bars;
+using quantlab::bench::set_bar_rate;
+using quantlab::bench::QuietStdout;
+
+// Signals only: the streaming MeanReversionStrategy::backtest
+void BM_StrategyBacktest(benchmark::State& state) {
+    const auto& bars = shared_gbm_bars(static_cast<size_t>(state.range(0)));
+    quantlab::strategy::MeanReversionStrategy strategy(20, 14, 20, 2.0, nullptr);
+    strategy.use_historical_data(bars.view());
+    QuietStdout quiet;
+    for (auto _ : state) {
+        size_t buys = 0;
+        strategy.backtest([&buys](const quantlab::strategy::StrategyResult& result) {
+            buys += result.signal == quantlab::strategy::Signal::BUY;
+        });
+        benchmark::DoNotOptimize(buys);
+    }
+    set_bar_rate(state, bars.size());
+}
+
+// Same signals from the compile-time pipeline
+void BM_StaticPipelineBacktest(benchmark::State& state) {
+    const auto& bars = shared_gbm_bars(static_cast<size_t>(state.range(0)));
+    quantlab::strategy::MeanReversionPipeline<> strategy;
+    strategy.use_historical_data(bars.view());
+    for (auto _ : state) {
+        size_t buys = 0;
+        strategy.backtest([&buys](const quantlab::strategy::StrategyResult& result) {
+            buys += result.signal == quantlab::strategy::Signal::BUY;
+        });
+        benchmark::DoNotOptimize(buys);
+    }
+    set_bar_rate(state, bars.size());
+}
+
+// End to end as the apps run it: strategy -> engine -> fills -> final metrics
+void BM_RunStrategyBacktest(benchmark::State& state) {
+    const auto& bars = shared_gbm_bars(static_cast<size_t>(state.range(0)));
+    quantlab::strategy::MeanReversionStrategy strategy(20, 14, 20, 2.0, nullptr);
+    strategy.use_historical_data(bars.view());
+    QuietStdout quiet;
+    for (auto _ : state) {
+        quantlab::backtest::BacktestEngine engine(100000.0);
+        quantlab::backtest::run_strategy_backtest(strategy, engine, 0.65, bars.view().close.back());
+        benchmark::DoNotOptimize(engine.get_metrics().total_return_pct);
+    }
+    set_bar_rate(state, bars.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_StrategyBacktest)->ArgName("bars")->RangeMultiplier(10)->Range(10000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StaticPipelineBacktest)->ArgName("bars")->RangeMultiplier(10)->Range(10000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunStrategyBacktest)->ArgName("bars")->RangeMultiplier(10)->Range(10000, 10000000)->Unit(benchmark::kMillisecond);
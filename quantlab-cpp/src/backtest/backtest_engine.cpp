@@ -1,4 +1,5 @@
 #include "backtest_engine.hpp"
+#include "../core/profiler.hpp"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -6,99 +7,103 @@
 
 namespace quantlab::backtest {
 
-void BacktestEngine::calculate_final_metrics(double final_price) {
-    metrics_.ending_capital = portfolio_.get_total_value(final_price);
-    metrics_.current_position_value = portfolio_.shares_held * final_price;
-    
-    // Calculate total return
-    metrics_.total_return_pct = ((metrics_.ending_capital - metrics_.starting_capital) / metrics_.starting_capital) * 100.0;
-    
-    // Analyze trades - count all individual transactions
-    metrics_.total_trades = portfolio_.trade_history.size();
-    metrics_.winning_trades = 0;
-    metrics_.losing_trades = 0;
-    double total_wins = 0.0;
-    double total_losses = 0.0;
-    
-    // Calculate P&L from complete trading cycles (BUY->SELL pairs)
-    double current_position_cost = 0.0;
-    int current_shares = 0;
-    int completed_trades = 0;
+void BacktestEngine::on_bar(const MarketEvent& bar) {
+    // The previous bar is complete: mark it at its close
+    if (has_bar_ && !bar_marked_) mark_current_bar();
     
-    for (const auto& trade : portfolio_.trade_history) {
-        if (trade.action == "BUY") {
-            current_position_cost += trade.value;
-            current_shares += trade.shares;
-        } else if (trade.action == "SELL" && current_shares > 0) {
-            // Calculate profit/loss for this sell
-            double avg_cost_per_share = current_position_cost / current_shares;
-            double profit_loss = (trade.price - avg_cost_per_share) * trade.shares;
-            
-            completed_trades++;
-            
-            if (profit_loss > 0) {
-                metrics_.winning_trades++;
-                total_wins += profit_loss;
-            } else {
-                metrics_.losing_trades++;
-                total_losses += std::abs(profit_loss);
-            }
-            
-            // Update position - proportionally reduce cost basis
-            double shares_sold_ratio = static_cast<double>(trade.shares) / current_shares;
-            current_position_cost -= (current_position_cost * shares_sold_ratio);
-            current_shares -= trade.shares;
-        }
+    // Orders placed on the previous bar execute against this one
+    for (const auto& order : pending_orders_) {
+        apply_fill(fill_model_->fill(order, bar));
     }
+    pending_orders_.clear();
     
-    // Calculate trade statistics
-    if (completed_trades > 0) {
-        metrics_.win_rate_pct = (static_cast<double>(metrics_.winning_trades) / completed_trades) * 100.0;
-        metrics_.avg_win = (metrics_.winning_trades > 0) ? (total_wins / metrics_.winning_trades) : 0.0;
-        metrics_.avg_loss = (metrics_.losing_trades > 0) ? (total_losses / metrics_.losing_trades) : 0.0;
-        
-        // Fix profit factor calculation
-        if (total_losses > 0) {
-            metrics_.profit_factor = total_wins / total_losses;
-        } else if (total_wins > 0) {
-            metrics_.profit_factor = 999.99; // All wins, no losses = very high profit factor
-        } else {
-            metrics_.profit_factor = 0.0; // No wins or losses
-        }
+    current_bar_ = bar;
+    has_bar_ = true;
+    bar_marked_ = false;
+}
+
+void BacktestEngine::on_signal(quantlab::core::TradeAction action, double confidence,
+                               const quantlab::core::SignalReason& reason) {
+    assert(has_bar_ && "on_bar() must be called before on_signal()");
+    const double price = current_bar_.close;
+    
+    int shares = static_cast<int>(order_notional_ / price);
+    if (action == quantlab::core::TradeAction::SELL) {
+        if (portfolio_.shares_held <= 0) return;  // Long-only: nothing to sell
+        shares = std::min(shares, portfolio_.shares_held);
     }
     
-    // Calculate max drawdown - simplified version
-    metrics_.max_drawdown_pct = 0.0;
-    
-    if (!portfolio_.daily_values.empty()) {
-        // Use daily values if available
-        double peak = metrics_.starting_capital;
-        for (double value : portfolio_.daily_values) {
-            if (value > peak) {
-                peak = value;
-            }
-            double drawdown = ((peak - value) / peak) * 100.0;
-            if (drawdown > metrics_.max_drawdown_pct) {
-                metrics_.max_drawdown_pct = drawdown;
-            }
-        }
+    submit_order(OrderEvent{current_bar_.timestamp_ns, action, shares, price, confidence, reason});
+}
+
+void BacktestEngine::submit_order(const OrderEvent& order) {
+    if (fill_model_->timing() == FillTiming::NEXT_BAR_OPEN) {
+        pending_orders_.push_back(order);
     } else {
-        // Simplified calculation: assume worst case is starting with all cash
-        // then being fully invested at lowest point
-        double peak_value = std::max(metrics_.starting_capital, metrics_.ending_capital);
-        double current_cash = portfolio_.cash;
-        
-        if (peak_value > current_cash && peak_value > 0) {
-            metrics_.max_drawdown_pct = ((peak_value - current_cash) / peak_value) * 100.0;
-        }
+        assert(has_bar_ && "on_bar() must be called before submitting orders");
+        apply_fill(fill_model_->fill(order, current_bar_));
     }
-    
-    // Simple Sharpe ratio calculation (assumes 2% risk-free rate)
-    if (metrics_.total_return_pct > 2.0) {
-        metrics_.sharpe_ratio = (metrics_.total_return_pct - 2.0) / 15.0;  // Simple approximation
+}
+
+void BacktestEngine::apply_fill(const FillEvent& fill) {
+    bool executed;
+    if (fill.action == quantlab::core::TradeAction::BUY) {
+        executed = portfolio_.execute_buy(fill.price, fill.shares, fill.confidence, fill.reason,
+                                          fill.timestamp_ns, fill.commission);
+    } else {
+        executed = portfolio_.execute_sell(fill.price, fill.shares, fill.confidence, fill.reason,
+                                           fill.timestamp_ns, fill.commission);
+    }
+    if (executed) {
+        accumulator_.on_fill(fill.action, fill.price, fill.shares, fill.commission);
+        QUANTLAB_PROFILE_COUNT(FILLS, 1);
     }
 }
 
+void BacktestEngine::mark_current_bar() {
+    double value = portfolio_.get_total_value(current_bar_.close);
+    accumulator_.on_mark(value);
+    portfolio_.peak_value = accumulator_.peak_value();
+    if (record_daily_values_) portfolio_.daily_values.push_back(value);
+    bar_marked_ = true;
+}
+
+void BacktestEngine::fill_metrics(BacktestMetrics& metrics, double final_price) const {
+    metrics.ending_capital = portfolio_.get_total_value(final_price);
+    metrics.current_position_value = portfolio_.shares_held * final_price;
+    
+    // Calculate total return
+    metrics.total_return_pct = ((metrics.ending_capital - metrics.starting_capital) / metrics.starting_capital) * 100.0;
+    metrics.annual_return_pct = accumulator_.annual_return_pct();
+    
+    // Trade statistics: every transaction, and P&L from complete BUY->SELL cycles
+    metrics.total_trades = portfolio_.trade_history.size();
+    metrics.winning_trades = accumulator_.winning_trades();
+    metrics.losing_trades = accumulator_.losing_trades();
+    metrics.win_rate_pct = accumulator_.win_rate_pct();
+    metrics.avg_win = accumulator_.avg_win();
+    metrics.avg_loss = accumulator_.avg_loss();
+    metrics.profit_factor = accumulator_.profit_factor();
+    
+    // Risk statistics from the bar-close marks
+    metrics.max_capital = accumulator_.peak_value();
+    metrics.max_drawdown_pct = accumulator_.max_drawdown_pct();
+    metrics.sharpe_ratio = accumulator_.sharpe_ratio();
+    metrics.sortino_ratio = accumulator_.sortino_ratio();
+}
+
+BacktestMetrics BacktestEngine::current_metrics() const {
+    BacktestMetrics metrics = metrics_;
+    fill_metrics(metrics, has_bar_ ? current_bar_.close : 0.0);
+    return metrics;
+}
+
+void BacktestEngine::calculate_final_metrics(double final_price) {
+    QUANTLAB_PROFILE_HOT_SCOPE(EXECUTION);
+    if (has_bar_ && !bar_marked_) mark_current_bar();
+    fill_metrics(metrics_, final_price);
+}
+
 void BacktestEngine::print_results() const {
     std::cout << "\n" << std::string(50, '=') << std::endl;
     std::cout << "BACKTEST RESULTS" << std::endl;
@@ -120,6 +125,7 @@ void BacktestEngine::print_results() const {
     std::cout << "\nRISK METRICS:" << std::endl;
     std::cout << "Max Drawdown:     " << std::fixed << std::setprecision(2) << metrics_.max_drawdown_pct << "%" << std::endl;
     std::cout << "Sharpe Ratio:     " << std::fixed << std::setprecision(2) << metrics_.sharpe_ratio << std::endl;
+    std::cout << "Sortino Ratio:    " << std::fixed << std::setprecision(2) << metrics_.sortino_ratio << std::endl;
     
     // Trade Statistics
     std::cout << "\nTRADE ANALYSIS:" << std::endl;
@@ -154,14 +160,17 @@ void BacktestEngine::print_trade_summary() const {
     for (size_t i = start_idx; i < portfolio_.trade_history.size(); ++i) {
         const auto& trade = portfolio_.trade_history[i];
         
-        std::string action_symbol = (trade.action == "BUY") ? "🟢 BUY " : "🔴 SELL";
+        const char* action_symbol = (trade.action == quantlab::core::TradeAction::BUY) ? "🟢 BUY " : "🔴 SELL";
         
         std::cout << action_symbol << " " << trade.shares << " shares @ $" 
                   << std::fixed << std::setprecision(2) << trade.price 
                   << " | Value: $" << std::fixed << std::setprecision(2) << trade.value
-                  << " | Conf: " << std::fixed << std::setprecision(0) << (trade.confidence * 100) << "%"
-                  << std::endl;
-        std::cout << "   Reason: " << trade.reason << std::endl;
+                  << " | Conf: " << std::fixed << std::setprecision(0) << (trade.confidence * 100) << "%";
+        if (trade.commission > 0.0) {
+            std::cout << " | Fee: $" << std::fixed << std::setprecision(2) << trade.commission;
+        }
+        std::cout << std::endl;
+        std::cout << "   Reason: " << trade.reason.to_string() << std::endl;
     }
 }
 
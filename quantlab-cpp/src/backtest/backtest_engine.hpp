@@ -2,25 +2,36 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <memory>
+#include <cassert>
+#include "../core/signal_types.hpp"
+#include "../core/symbol_table.hpp"
+#include "events.hpp"
+#include "fill_model.hpp"
+#include "metrics_accumulator.hpp"
 
 namespace quantlab::backtest {
 
 struct Trade {
-    std::string timestamp;
-    std::string action;        // "BUY" or "SELL"
+    int64_t timestamp_ns;      // Bar time of the fill (0 when unknown)
+    quantlab::core::TradeAction action;
     double price;
     int shares;
     double value;              // price * shares
+    double commission;         // Paid on top of value (buys) or out of it (sells)
     double confidence;
-    std::string reason;
+    quantlab::core::SignalReason reason;  // Formatted only when printed
+    quantlab::core::SymbolId symbol_id = 0;  // Asset traded (multi-asset backtests; 0 otherwise)
 };
 
 struct BacktestMetrics {
     // Performance Metrics
     double total_return_pct = 0.0;           // Total % return
     double annual_return_pct = 0.0;          // Annualized return
-    double sharpe_ratio = 0.0;               // Risk-adjusted return
-    double max_drawdown_pct = 0.0;           // Worst losing streak
+    double sharpe_ratio = 0.0;               // Annualized, per-bar returns over a 2% risk-free rate
+    double sortino_ratio = 0.0;              // Same, penalizing only downside deviation
+    double max_drawdown_pct = 0.0;           // Worst peak-to-trough fall of the marked portfolio value
     
     // Trade Statistics
     int total_trades = 0;
@@ -45,57 +56,147 @@ struct Portfolio {
     std::vector<Trade> trade_history;
     
     // Performance tracking
-    std::vector<double> daily_values;        // Portfolio value each day
+    std::vector<double> daily_values;        // Portfolio value each bar (only when the engine records them)
     double peak_value = 100000.0;            // Highest portfolio value seen
     
     double get_total_value(double current_price) const {
         return cash + (shares_held * current_price);
     }
     
-    bool can_buy(double price, int shares) const {
-        return cash >= (price * shares);
+    bool can_buy(double price, int shares, double commission = 0.0) const {
+        return cash >= (price * shares) + commission;
     }
     
-    void execute_buy(double price, int shares, double confidence, const std::string& reason) {
-        if (can_buy(price, shares)) {
+    // Both execute_* return whether the trade went through
+    bool execute_buy(double price, int shares, double confidence,
+                     const quantlab::core::SignalReason& reason, int64_t timestamp_ns = 0,
+                     double commission = 0.0) {
+        if (can_buy(price, shares, commission)) {
             double cost = price * shares;
-            cash -= cost;
+            cash -= cost + commission;
             shares_held += shares;
             last_buy_price = price;
             
             trade_history.push_back({
-                "timestamp", "BUY", price, shares, cost, confidence, reason
+                timestamp_ns, quantlab::core::TradeAction::BUY, price, shares, cost, commission, confidence, reason
             });
+            return true;
         }
+        return false;
     }
     
-    void execute_sell(double price, int shares, double confidence, const std::string& reason) {
+    bool execute_sell(double price, int shares, double confidence,
+                      const quantlab::core::SignalReason& reason, int64_t timestamp_ns = 0,
+                      double commission = 0.0) {
         if (shares_held >= shares) {
             double proceeds = price * shares;
-            cash += proceeds;
+            cash += proceeds - commission;
             shares_held -= shares;
             
             trade_history.push_back({
-                "timestamp", "SELL", price, shares, proceeds, confidence, reason
+                timestamp_ns, quantlab::core::TradeAction::SELL, price, shares, proceeds, commission, confidence, reason
             });
+            return true;
         }
+        return false;
     }
 };
 
+/**
+ * Event-driven backtest core
+ *
+ * Per bar the caller feeds one MarketEvent via on_bar(), then at most one
+ * signal via on_signal():
+ *
+ *   on_bar(bar)        fills orders queued for this bar (next-bar-open fills)
+ *   on_signal(...)     sizes an OrderEvent (fixed notional per ticket) and hands
+ *                      it to the FillModel - filled on this bar or queued
+ *   FillEvent          applied to the Portfolio (cash, shares, trade history)
+ *
+ * The default SimpleFillModel fills at the signal bar's close with no costs,
+ * which is exactly the old inline "$50k at current_price" logic. Orders still
+ * queued when the data ends are dropped. Portfolio::execute_buy/sell remain
+ * available for callers that manage execution themselves, but only fills
+ * routed through the engine reach the metrics.
+ *
+ * Metrics are accumulated online: every fill updates the trade-cycle P&L and
+ * every bar is marked to market at its close (once the next bar arrives, or
+ * in calculate_final_metrics for the last one). current_metrics() is O(1) at any
+ * point of the run; no per-bar history is stored unless record_daily_values is on.
+ */
 class BacktestEngine {
 private:
     Portfolio portfolio_;
     BacktestMetrics metrics_;
     
+    std::shared_ptr<const FillModel> fill_model_;
+    double order_notional_;                 // $ per order ticket
+    
+    MarketEvent current_bar_{};
+    bool has_bar_ = false;
+    std::vector<OrderEvent> pending_orders_;  // Waiting for the next bar (NEXT_BAR_OPEN)
+    
+    MetricsAccumulator accumulator_;
+    bool bar_marked_ = false;               // current_bar_ already marked to market
+    bool record_daily_values_ = false;
+    
+    void apply_fill(const FillEvent& fill);
+    void mark_current_bar();
+    void fill_metrics(BacktestMetrics& metrics, double final_price) const;
+    
 public:
-    BacktestEngine(double starting_capital = 100000.0) {
+    static constexpr double DEFAULT_ORDER_NOTIONAL = 50000.0;
+    
+    // Bump whenever a change alters backtest results (engine, fill models, metrics, strategy
+    // signals); persisted results computed under another version are discarded
+    static constexpr uint32_t RESULTS_VERSION = 1;
+    
+    BacktestEngine(double starting_capital = 100000.0)
+        : fill_model_(std::make_shared<SimpleFillModel>()), order_notional_(DEFAULT_ORDER_NOTIONAL),
+          accumulator_(starting_capital) {
         portfolio_.cash = starting_capital;
+        portfolio_.peak_value = starting_capital;
         metrics_.starting_capital = starting_capital;
     }
     
     Portfolio& get_portfolio() { return portfolio_; }
+    const Portfolio& get_portfolio() const { return portfolio_; }
     const BacktestMetrics& get_metrics() const { return metrics_; }
     
+    // Execution model (shared, so one model can serve many engines in a sweep)
+    void set_fill_model(std::shared_ptr<const FillModel> model) {
+        if (model) fill_model_ = std::move(model);
+    }
+    const FillModel& fill_model() const { return *fill_model_; }
+    
+    // Dollar size of each order ticket (default $50k)
+    void set_order_notional(double notional) {
+        if (notional > 0.0) order_notional_ = notional;
+    }
+    double order_notional() const { return order_notional_; }
+    
+    // Keep every bar's portfolio value in Portfolio::daily_values (off by default; metrics don't need it)
+    void set_record_daily_values(bool record) { record_daily_values_ = record; }
+    
+    // EVENT LOOP
+    // New bar: execute orders queued for this bar, then make it the current bar
+    void on_bar(const MarketEvent& bar);
+    
+    // Signal on the current bar: BUY sizes a full ticket, SELL sizes a ticket capped at the
+    // position (ignored when flat). Call after on_bar() for the same bar.
+    void on_signal(quantlab::core::TradeAction action, double confidence,
+                   const quantlab::core::SignalReason& reason);
+    
+    // Route an already sized order through the fill model
+    void submit_order(const OrderEvent& order);
+    
+    size_t pending_order_count() const { return pending_orders_.size(); }
+    
+    // Metrics as of the latest mark, valued at the latest bar close (O(1), usable mid-run)
+    BacktestMetrics current_metrics() const;
+    const MetricsAccumulator& accumulator() const { return accumulator_; }
+    
+    // Mark the last bar and finalize get_metrics(), valuing the position at final_price
     void calculate_final_metrics(double final_price);
     void print_results() const;
     void print_trade_summary() const;
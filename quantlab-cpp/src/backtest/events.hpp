@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include "../core/signal_types.hpp"
+
+namespace quantlab::backtest {
+
+/**
+ * Events flowing through the backtest loop
+ *
+ *   MarketEvent  - a new bar is available                (data -> engine)
+ *   OrderEvent   - a sized order was placed on a signal  (engine -> fill model)
+ *   FillEvent    - the fill model executed an order      (fill model -> portfolio)
+ *
+ * All three are small trivially copyable structs; nothing on this path allocates.
+ */
+struct MarketEvent {
+    int64_t timestamp_ns;
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+struct OrderEvent {
+    int64_t timestamp_ns;               // Bar the order was placed on
+    quantlab::core::TradeAction action;
+    int shares;
+    double reference_price;             // Price the order was sized at (signal bar close)
+    double confidence;
+    quantlab::core::SignalReason reason;
+};
+
+struct FillEvent {
+    int64_t timestamp_ns;               // Bar the order was filled on
+    quantlab::core::TradeAction action;
+    int shares;
+    double price;                       // Execution price after slippage
+    double commission;                  // Total commission for the fill
+    double confidence;
+    quantlab::core::SignalReason reason;
+};
+
+} // namespace quantlab::backtest
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include "events.hpp"
+
+namespace quantlab::backtest {
+
+/**
+ * When an order placed on a bar gets executed
+ */
+enum class FillTiming {
+    BAR_CLOSE,       // Same bar, at its close (the signal price)
+    NEXT_BAR_OPEN    // Next bar, at its open (no look-ahead on the signal bar)
+};
+
+/**
+ * Execution model interface
+ *
+ * The engine asks timing() once per order to decide whether to fill it on the
+ * signal bar or queue it for the next one, then calls fill() with the bar the
+ * order executes against. Implementations decide price and commission.
+ */
+class FillModel {
+public:
+    virtual ~FillModel() = default;
+
+    virtual FillTiming timing() const = 0;
+    virtual FillEvent fill(const OrderEvent& order, const MarketEvent& bar) const = 0;
+};
+
+/**
+ * Fill at close or next open with proportional slippage and per-share commission
+ *
+ * Defaults (close fill, no slippage, no commission) reproduce the original
+ * instant-fill-at-signal-price behaviour exactly.
+ */
+class SimpleFillModel : public FillModel {
+private:
+    FillTiming timing_;
+    double slippage_bps_;          // Adverse price move per fill, in basis points of the fill price
+    double commission_per_share_;  // $ per share
+    double min_commission_;        // $ floor per fill
+
+public:
+    explicit SimpleFillModel(FillTiming timing = FillTiming::BAR_CLOSE, double slippage_bps = 0.0,
+                             double commission_per_share = 0.0, double min_commission = 0.0)
+        : timing_(timing), slippage_bps_(slippage_bps),
+          commission_per_share_(commission_per_share), min_commission_(min_commission) {}
+
+    FillTiming timing() const override { return timing_; }
+
+    FillEvent fill(const OrderEvent& order, const MarketEvent& bar) const override {
+        double base_price = (timing_ == FillTiming::NEXT_BAR_OPEN) ? bar.open : bar.close;
+        double slippage = base_price * slippage_bps_ / 10000.0;
+        double price = (order.action == quantlab::core::TradeAction::BUY) ? base_price + slippage
+                                                                          : base_price - slippage;
+        double commission = order.shares > 0 ? std::max(min_commission_, commission_per_share_ * order.shares) : 0.0;
+        return FillEvent{bar.timestamp_ns, order.action, order.shares, price, commission,
+                         order.confidence, order.reason};
+    }
+};
+
+} // namespace quantlab::backtest
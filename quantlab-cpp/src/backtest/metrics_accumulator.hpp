@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include "../core/signal_types.hpp"
+
+namespace quantlab::backtest {
+
+/**
+ * Running backtest statistics, updated per fill and per mark-to-market
+ *
+ * Everything is O(1) per update and O(1) to read, so metrics are available
+ * mid-run and no per-bar value history has to be kept:
+ *
+ *   on_fill()  average-cost BUY->SELL cycle P&L (wins, losses, profit factor)
+ *   on_mark()  peak / max drawdown, and Welford mean/variance of the per-mark
+ *              returns for an annualized Sharpe; downside deviation for Sortino
+ *
+ * Marks are assumed to be one per bar of a daily series (252 per year) with a
+ * 2% annual risk-free rate, the same convention the old placeholder used.
+ */
+class MetricsAccumulator {
+private:
+    double starting_capital_ = 0.0;
+
+    // Trade cycles (same matching as the old trade_history scan)
+    double position_cost_ = 0.0;
+    int position_shares_ = 0;
+    int winning_trades_ = 0;
+    int losing_trades_ = 0;
+    double total_wins_ = 0.0;
+    double total_losses_ = 0.0;   // Positive number
+
+    // Equity curve
+    double last_value_ = 0.0;
+    double peak_value_ = 0.0;
+    double max_drawdown_pct_ = 0.0;
+    size_t marks_ = 0;
+    double return_mean_ = 0.0;
+    double return_m2_ = 0.0;
+    double downside_sq_sum_ = 0.0;  // Sum of squared below-risk-free excess returns
+
+    static double risk_free_per_period() { return RISK_FREE_RATE / PERIODS_PER_YEAR; }
+
+public:
+    static constexpr double PERIODS_PER_YEAR = 252.0;
+    static constexpr double RISK_FREE_RATE = 0.02;
+
+    explicit MetricsAccumulator(double starting_capital = 100000.0)
+        : starting_capital_(starting_capital), last_value_(starting_capital), peak_value_(starting_capital) {}
+
+    void reset(double starting_capital) { *this = MetricsAccumulator(starting_capital); }
+
+    // An executed fill (value = price * shares; commission on top of it)
+    void on_fill(quantlab::core::TradeAction action, double price, int shares, double commission) {
+        if (action == quantlab::core::TradeAction::BUY) {
+            position_cost_ += price * shares + commission;
+            position_shares_ += shares;
+        } else if (position_shares_ > 0) {
+            double avg_cost_per_share = position_cost_ / position_shares_;
+            double profit_loss = (price - avg_cost_per_share) * shares - commission;
+
+            if (profit_loss > 0) {
+                winning_trades_++;
+                total_wins_ += profit_loss;
+            } else {
+                losing_trades_++;
+                total_losses_ += std::abs(profit_loss);
+            }
+
+            // Proportionally reduce the cost basis
+            double shares_sold_ratio = static_cast<double>(shares) / position_shares_;
+            position_cost_ -= (position_cost_ * shares_sold_ratio);
+            position_shares_ -= shares;
+        }
+    }
+
+    // Portfolio value at the end of a period
+    void on_mark(double portfolio_value) {
+        peak_value_ = std::max(peak_value_, portfolio_value);
+        if (peak_value_ > 0) {
+            max_drawdown_pct_ = std::max(max_drawdown_pct_, ((peak_value_ - portfolio_value) / peak_value_) * 100.0);
+        }
+
+        double period_return = (last_value_ != 0.0) ? (portfolio_value / last_value_ - 1.0) : 0.0;
+        last_value_ = portfolio_value;
+
+        ++marks_;
+        double delta = period_return - return_mean_;
+        return_mean_ += delta / static_cast<double>(marks_);
+        return_m2_ += delta * (period_return - return_mean_);
+
+        double excess = period_return - risk_free_per_period();
+        if (excess < 0) downside_sq_sum_ += excess * excess;
+    }
+
+    // Trade statistics
+    int winning_trades() const { return winning_trades_; }
+    int losing_trades() const { return losing_trades_; }
+    int completed_trades() const { return winning_trades_ + losing_trades_; }
+    double total_wins() const { return total_wins_; }
+    double total_losses() const { return total_losses_; }
+
+    double win_rate_pct() const {
+        int completed = completed_trades();
+        return completed > 0 ? (static_cast<double>(winning_trades_) / completed) * 100.0 : 0.0;
+    }
+    double avg_win() const { return winning_trades_ > 0 ? total_wins_ / winning_trades_ : 0.0; }
+    double avg_loss() const { return losing_trades_ > 0 ? total_losses_ / losing_trades_ : 0.0; }
+    double profit_factor() const {
+        if (total_losses_ > 0) return total_wins_ / total_losses_;
+        if (total_wins_ > 0) return 999.99;  // All wins, no losses = very high profit factor
+        return 0.0;
+    }
+
+    // Equity curve statistics
+    size_t marks() const { return marks_; }
+    double last_value() const { return last_value_; }
+    double peak_value() const { return peak_value_; }
+    double max_drawdown_pct() const { return max_drawdown_pct_; }
+
+    // Compounded return over the marked periods, annualized
+    double annual_return_pct() const {
+        if (marks_ == 0 || starting_capital_ <= 0 || last_value_ <= 0) return 0.0;
+        return (std::pow(last_value_ / starting_capital_, PERIODS_PER_YEAR / static_cast<double>(marks_)) - 1.0) * 100.0;
+    }
+
+    double sharpe_ratio() const {
+        if (marks_ < 2) return 0.0;
+        double stddev = std::sqrt(return_m2_ / static_cast<double>(marks_ - 1));
+        if (stddev <= 0.0) return 0.0;
+        return (return_mean_ - risk_free_per_period()) / stddev * std::sqrt(PERIODS_PER_YEAR);
+    }
+
+    double sortino_ratio() const {
+        if (marks_ < 2) return 0.0;
+        double downside = std::sqrt(downside_sq_sum_ / static_cast<double>(marks_));
+        if (downside <= 0.0) return 0.0;
+        return (return_mean_ - risk_free_per_period()) / downside * std::sqrt(PERIODS_PER_YEAR);
+    }
+};
+
+} // namespace quantlab::backtest
@@ -0,0 +1,168 @@
+#include "multi_asset_backtest.hpp"
+#include "strategy_runner.hpp"
+#include "../data/merged_timeline.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace quantlab::backtest {
+
+static double profit_factor_of(double wins, double losses) {
+    // Same convention as BacktestEngine::calculate_final_metrics
+    if (losses > 0) return wins / losses;
+    if (wins > 0) return 999.99;
+    return 0.0;
+}
+
+quantlab::core::SymbolId MultiAssetBacktest::add_symbol(const std::string& symbol,
+                                                        quantlab::core::BarColumnsView bars,
+                                                        quantlab::strategy::MeanReversionStrategy strategy,
+                                                        double confidence_threshold) {
+    if (auto existing = symbols_.find(symbol)) {
+        std::cerr << "⚠️  " << symbol << " already added to the multi-asset backtest, ignoring" << std::endl;
+        return *existing;
+    }
+
+    quantlab::core::SymbolId id = symbols_.intern(symbol);
+    size_t warmup = quantlab::strategy::MeanReversionStrategy::warmup_bars(bars.size());
+    assets_.push_back(Asset{bars, std::move(strategy), confidence_threshold, warmup, {},
+                            MetricsAccumulator(starting_capital_)});
+    portfolio_.resize(symbols_.size());
+    return id;
+}
+
+void MultiAssetBacktest::on_signal(quantlab::core::SymbolId id, const MarketEvent& bar,
+                                   const quantlab::strategy::StrategyResult& signal_result) {
+    if (signal_result.confidence < assets_[id].confidence_threshold) return;
+
+    quantlab::core::TradeAction action;
+    if (signal_result.signal == quantlab::strategy::Signal::BUY) {
+        action = quantlab::core::TradeAction::BUY;
+    } else if (signal_result.signal == quantlab::strategy::Signal::SELL) {
+        action = quantlab::core::TradeAction::SELL;
+    } else {
+        return;
+    }
+
+    // Same sizing as BacktestEngine::on_signal: one ticket, sells capped at the position
+    int shares = static_cast<int>(order_notional_ / bar.close);
+    if (action == quantlab::core::TradeAction::SELL) {
+        int held = portfolio_.position(id).shares;
+        if (held <= 0) return;  // Long-only: nothing to sell
+        shares = std::min(shares, held);
+    }
+
+    submit_order(id, OrderEvent{bar.timestamp_ns, action, shares, bar.close,
+                                signal_result.confidence, signal_result.reason}, bar);
+}
+
+void MultiAssetBacktest::submit_order(quantlab::core::SymbolId id, const OrderEvent& order, const MarketEvent& bar) {
+    if (fill_model_->timing() == FillTiming::NEXT_BAR_OPEN) {
+        assets_[id].pending_orders.push_back(order);
+    } else {
+        portfolio_.apply_fill(id, fill_model_->fill(order, bar));
+    }
+}
+
+PortfolioSummary MultiAssetBacktest::run() {
+    std::vector<quantlab::core::BarColumnsView> streams;
+    streams.reserve(assets_.size());
+    for (auto& asset : assets_) {
+        asset.strategy.reset_indicators();
+        asset.pending_orders.clear();
+        asset.contribution.reset(starting_capital_);
+        streams.push_back(asset.bars);
+    }
+
+    quantlab::data::MergedTimeline timeline(std::move(streams));
+    quantlab::data::TimelineEvent event;
+
+    MetricsAccumulator curve(starting_capital_);
+    double peak_gross_exposure = 0.0;
+    size_t events = 0;
+
+    while (timeline.next(event)) {
+        Asset& asset = assets_[event.symbol];
+        const MarketEvent bar = market_event(asset.bars, event.index);
+
+        // Orders placed on this symbol's previous bar execute against this one
+        for (const auto& order : asset.pending_orders) {
+            portfolio_.apply_fill(event.symbol, fill_model_->fill(order, bar));
+        }
+        asset.pending_orders.clear();
+
+        if (event.index < asset.warmup) {
+            asset.strategy.warm_up_bar(bar.close);
+        } else {
+            on_signal(event.symbol, bar, asset.strategy.on_bar(bar.close));
+        }
+
+        portfolio_.mark(event.symbol, bar.close);
+        ++events;
+
+        const Position& position = portfolio_.position(event.symbol);
+        asset.contribution.on_mark(starting_capital_ + position.realized_pnl + position.unrealized_pnl());
+
+        // Portfolio-level marks once every asset trading at this timestamp has been updated
+        if (timeline.empty() || timeline.next_timestamp() != event.timestamp_ns) {
+            curve.on_mark(portfolio_.total_value());
+            peak_gross_exposure = std::max(peak_gross_exposure, portfolio_.gross_exposure());
+        }
+    }
+
+    return summarize(curve, peak_gross_exposure, events);
+}
+
+PortfolioSummary MultiAssetBacktest::summarize(const MetricsAccumulator& curve, double peak_gross_exposure,
+                                               size_t events) const {
+    PortfolioSummary summary;
+    summary.starting_capital = starting_capital_;
+    summary.ending_capital = portfolio_.total_value();
+    summary.total_return_pct = ((summary.ending_capital - starting_capital_) / starting_capital_) * 100.0;
+    summary.max_drawdown_pct = curve.max_drawdown_pct();
+    summary.sharpe_ratio = curve.sharpe_ratio();
+    summary.sortino_ratio = curve.sortino_ratio();
+    summary.peak_gross_exposure = peak_gross_exposure;
+    summary.total_trades = static_cast<int>(portfolio_.trade_history().size());
+    summary.events = events;
+
+    double total_wins = 0.0;
+    double total_losses = 0.0;
+
+    summary.assets.reserve(assets_.size());
+    for (quantlab::core::SymbolId id = 0; id < assets_.size(); ++id) {
+        const Position& position = portfolio_.position(id);
+        AssetSummary asset;
+        asset.symbol = symbols_.name(id);
+        asset.bars = assets_[id].bars.size();
+        asset.total_trades = position.trades;
+        asset.winning_trades = position.winning_cycles;
+        asset.losing_trades = position.losing_cycles;
+        int cycles = position.winning_cycles + position.losing_cycles;
+        if (cycles > 0) {
+            asset.win_rate_pct = (static_cast<double>(position.winning_cycles) / cycles) * 100.0;
+            asset.profit_factor = profit_factor_of(position.gross_wins, position.gross_losses);
+        }
+        asset.realized_pnl = position.realized_pnl;
+        asset.unrealized_pnl = position.unrealized_pnl();
+        asset.return_contribution_pct = ((asset.realized_pnl + asset.unrealized_pnl) / starting_capital_) * 100.0;
+        asset.max_drawdown_contribution_pct = assets_[id].contribution.max_drawdown_pct();
+        asset.sharpe_ratio = assets_[id].contribution.sharpe_ratio();
+        asset.shares_held = position.shares;
+        asset.market_value = position.market_value();
+        summary.assets.push_back(std::move(asset));
+
+        summary.winning_trades += position.winning_cycles;
+        summary.losing_trades += position.losing_cycles;
+        total_wins += position.gross_wins;
+        total_losses += position.gross_losses;
+    }
+
+    int completed = summary.winning_trades + summary.losing_trades;
+    if (completed > 0) {
+        summary.win_rate_pct = (static_cast<double>(summary.winning_trades) / completed) * 100.0;
+        summary.profit_factor = profit_factor_of(total_wins, total_losses);
+    }
+    return summary;
+}
+
+} // namespace quantlab::backtest
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "multi_asset_portfolio.hpp"
+#include "fill_model.hpp"
+#include "metrics_accumulator.hpp"
+#include "../core/symbol_table.hpp"
+#include "../strategy/mean_reversion_strategy.hpp"
+
+namespace quantlab::backtest {
+
+/**
+ * Per-asset results of a multi-asset run
+ *
+ * Returns, drawdowns and Sharpe are contributions: this asset's P&L on top of
+ * the whole portfolio's starting capital, marked at each of its bar closes.
+ */
+struct AssetSummary {
+    std::string symbol;
+    size_t bars = 0;
+    int total_trades = 0;
+    int winning_trades = 0;
+    int losing_trades = 0;
+    double win_rate_pct = 0.0;
+    double profit_factor = 0.0;
+    double realized_pnl = 0.0;
+    double unrealized_pnl = 0.0;
+    double return_contribution_pct = 0.0;
+    double max_drawdown_contribution_pct = 0.0;
+    double sharpe_ratio = 0.0;
+    int shares_held = 0;
+    double market_value = 0.0;
+};
+
+struct PortfolioSummary {
+    double starting_capital = 0.0;
+    double ending_capital = 0.0;             // Cash + positions at each asset's last close
+    double total_return_pct = 0.0;
+    double max_drawdown_pct = 0.0;           // Sampled once per timestamp, after every asset has been marked
+    double sharpe_ratio = 0.0;               // Same marks; see MetricsAccumulator
+    double sortino_ratio = 0.0;
+    double peak_gross_exposure = 0.0;
+    int total_trades = 0;
+    int winning_trades = 0;
+    int losing_trades = 0;
+    double win_rate_pct = 0.0;
+    double profit_factor = 0.0;
+    size_t events = 0;                       // Bars processed across all assets
+    std::vector<AssetSummary> assets;        // Indexed by SymbolId
+};
+
+/**
+ * One-pass backtest of a whole universe against a single shared-cash portfolio
+ *
+ * Each symbol brings its own strategy instance and bar history. The bars are
+ * merged by timestamp (MergedTimeline, O(log k) per bar for k symbols) and
+ * every bar flows through the same signal -> order -> fill path as
+ * BacktestEngine: the first warmup_bars(n) bars of a symbol only warm its
+ * indicators, later bars are evaluated with the strategy's on_bar(), and
+ * signals above the symbol's confidence threshold become fixed-notional
+ * orders executed by the FillModel (next-bar-open orders fill on that
+ * symbol's next bar).
+ *
+ * Bar histories are borrowed; the caller keeps them alive until run() returns.
+ */
+class MultiAssetBacktest {
+private:
+    struct Asset {
+        quantlab::core::BarColumnsView bars;
+        quantlab::strategy::MeanReversionStrategy strategy;
+        double confidence_threshold;
+        size_t warmup;                          // Bars that only warm the indicators
+        std::vector<OrderEvent> pending_orders; // Waiting for this symbol's next bar
+        MetricsAccumulator contribution;        // Starting capital + this asset's P&L, per bar
+    };
+
+    double starting_capital_;
+    quantlab::core::SymbolTable symbols_;
+    std::vector<Asset> assets_;
+    MultiAssetPortfolio portfolio_;
+
+    std::shared_ptr<const FillModel> fill_model_;
+    double order_notional_;
+
+    void on_signal(quantlab::core::SymbolId id, const MarketEvent& bar,
+                   const quantlab::strategy::StrategyResult& signal_result);
+    void submit_order(quantlab::core::SymbolId id, const OrderEvent& order, const MarketEvent& bar);
+    PortfolioSummary summarize(const MetricsAccumulator& curve, double peak_gross_exposure, size_t events) const;
+
+public:
+    explicit MultiAssetBacktest(double starting_capital = 100000.0)
+        : starting_capital_(starting_capital), portfolio_(starting_capital),
+          fill_model_(std::make_shared<SimpleFillModel>()),
+          order_notional_(BacktestEngine::DEFAULT_ORDER_NOTIONAL) {}
+
+    void set_fill_model(std::shared_ptr<const FillModel> model) {
+        if (model) fill_model_ = std::move(model);
+    }
+
+    // Dollar size of each order ticket (default $50k), shared by all assets
+    void set_order_notional(double notional) {
+        if (notional > 0.0) order_notional_ = notional;
+    }
+
+    // Register a symbol; ids are assigned in registration order. Re-adding a symbol is ignored.
+    quantlab::core::SymbolId add_symbol(const std::string& symbol, quantlab::core::BarColumnsView bars,
+                                        quantlab::strategy::MeanReversionStrategy strategy,
+                                        double confidence_threshold);
+
+    // Walk the merged timeline once and return the portfolio and per-asset results.
+    // Orders still queued when a symbol's data ends are dropped.
+    PortfolioSummary run();
+
+    const quantlab::core::SymbolTable& symbols() const { return symbols_; }
+    const MultiAssetPortfolio& portfolio() const { return portfolio_; }
+};
+
+} // namespace quantlab::backtest
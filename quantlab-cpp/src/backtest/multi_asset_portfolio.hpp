@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include "backtest_engine.hpp"
+#include "../core/symbol_table.hpp"
+
+namespace quantlab::backtest {
+
+/**
+ * One asset's slot in the position table
+ *
+ * Cost basis uses the same average-cost rule as BacktestEngine's metrics:
+ * buys add price * shares + commission, sells release a proportional share
+ * and book (price - avg cost) * shares - commission as one completed cycle.
+ */
+struct Position {
+    int shares = 0;
+    double cost_basis = 0.0;      // Cost of the open shares, buy commissions included
+    double last_price = 0.0;      // Latest mark
+    double realized_pnl = 0.0;
+    double gross_wins = 0.0;
+    double gross_losses = 0.0;    // Positive number
+    int winning_cycles = 0;
+    int losing_cycles = 0;
+    int trades = 0;               // Fills on this asset
+
+    double market_value() const { return shares * last_price; }
+    double unrealized_pnl() const { return market_value() - cost_basis; }
+};
+
+/**
+ * Shared-cash, long-only portfolio over many assets
+ *
+ * Positions live in a vector indexed by SymbolId, so fills and marks are O(1)
+ * array accesses. The total market value is maintained incrementally on every
+ * mark and fill, which keeps total_value() O(1) regardless of universe size.
+ */
+class MultiAssetPortfolio {
+private:
+    double cash_;
+    std::vector<Position> positions_;
+    double market_value_ = 0.0;         // Sum of positions' shares * last_price
+    std::vector<Trade> trade_history_;
+
+public:
+    explicit MultiAssetPortfolio(double starting_capital = 100000.0, size_t symbols = 0)
+        : cash_(starting_capital), positions_(symbols) {}
+
+    // Grow the position table to cover `symbols` ids
+    void resize(size_t symbols) {
+        if (symbols > positions_.size()) positions_.resize(symbols);
+    }
+
+    // New price for one asset
+    void mark(quantlab::core::SymbolId id, double price) {
+        Position& position = positions_[id];
+        market_value_ += position.shares * (price - position.last_price);
+        position.last_price = price;
+    }
+
+    bool can_buy(double price, int shares, double commission = 0.0) const {
+        return cash_ >= (price * shares) + commission;
+    }
+
+    void execute_buy(quantlab::core::SymbolId id, const FillEvent& fill) {
+        if (fill.shares <= 0 || !can_buy(fill.price, fill.shares, fill.commission)) return;
+
+        Position& position = positions_[id];
+        double cost = fill.price * fill.shares;
+        cash_ -= cost + fill.commission;
+        position.shares += fill.shares;
+        position.cost_basis += cost + fill.commission;
+        position.trades++;
+        market_value_ += fill.shares * position.last_price;
+
+        trade_history_.push_back({
+            fill.timestamp_ns, quantlab::core::TradeAction::BUY, fill.price, fill.shares, cost,
+            fill.commission, fill.confidence, fill.reason, id
+        });
+    }
+
+    void execute_sell(quantlab::core::SymbolId id, const FillEvent& fill) {
+        Position& position = positions_[id];
+        if (fill.shares <= 0 || position.shares < fill.shares) return;
+
+        double proceeds = fill.price * fill.shares;
+        double avg_cost_per_share = position.cost_basis / position.shares;
+        double profit_loss = (fill.price - avg_cost_per_share) * fill.shares - fill.commission;
+
+        if (profit_loss > 0) {
+            position.winning_cycles++;
+            position.gross_wins += profit_loss;
+        } else {
+            position.losing_cycles++;
+            position.gross_losses += std::abs(profit_loss);
+        }
+        position.realized_pnl += profit_loss;
+
+        double shares_sold_ratio = static_cast<double>(fill.shares) / position.shares;
+        position.cost_basis -= position.cost_basis * shares_sold_ratio;
+        position.shares -= fill.shares;
+        position.trades++;
+        cash_ += proceeds - fill.commission;
+        market_value_ -= fill.shares * position.last_price;
+
+        trade_history_.push_back({
+            fill.timestamp_ns, quantlab::core::TradeAction::SELL, fill.price, fill.shares, proceeds,
+            fill.commission, fill.confidence, fill.reason, id
+        });
+    }
+
+    void apply_fill(quantlab::core::SymbolId id, const FillEvent& fill) {
+        if (fill.action == quantlab::core::TradeAction::BUY) {
+            execute_buy(id, fill);
+        } else {
+            execute_sell(id, fill);
+        }
+    }
+
+    double cash() const { return cash_; }
+    double gross_exposure() const { return market_value_; }   // Long-only: sum of position values
+    double total_value() const { return cash_ + market_value_; }
+
+    const Position& position(quantlab::core::SymbolId id) const {
+        assert(id < positions_.size());
+        return positions_[id];
+    }
+    size_t size() const { return positions_.size(); }
+    const std::vector<Trade>& trade_history() const { return trade_history_; }
+};
+
+} // namespace quantlab::backtest
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <span>
+#include "backtest_engine.hpp"
+#include "../core/bar_aggregator.hpp"
+#include "../core/profiler.hpp"
+#include "../strategy/mean_reversion_strategy.hpp"
+
+namespace quantlab::backtest {
+
+// Bar i of a columnar history as a MarketEvent
+inline MarketEvent market_event(const quantlab::core::BarColumnsView& bars, size_t i) {
+    return MarketEvent{bars.timestamp_ns[i], bars.open[i], bars.high[i], bars.low[i], bars.close[i]};
+}
+
+// Turn a strategy signal into an engine order when it clears the confidence threshold
+inline void route_signal(BacktestEngine& engine, const quantlab::strategy::StrategyResult& signal_result,
+                         double confidence_threshold) {
+    if (signal_result.confidence < confidence_threshold) return;
+    
+    if (signal_result.signal == quantlab::strategy::Signal::BUY) {
+        engine.on_signal(quantlab::core::TradeAction::BUY, signal_result.confidence, signal_result.reason);
+    } else if (signal_result.signal == quantlab::strategy::Signal::SELL) {
+        engine.on_signal(quantlab::core::TradeAction::SELL, signal_result.confidence, signal_result.reason);
+    }
+}
+
+/**
+ * The one backtest loop shared by the apps
+ *
+ * Streams the strategy's signals, and for each bar feeds the engine its
+ * MarketEvent followed by the bar's signal. Metrics are finalized at the
+ * last bar's close, like walk-forward folds and TickBacktest, or at
+ * fallback_price when the strategy produced no signals.
+ *
+ * Returns the price the metrics were marked at.
+ */
+inline double run_strategy_backtest(quantlab::strategy::MeanReversionStrategy& strategy, BacktestEngine& engine,
+                                    double confidence_threshold, double fallback_price) {
+    const quantlab::core::BarColumnsView& bars = strategy.bars();
+    size_t bar_index = quantlab::strategy::MeanReversionStrategy::warmup_bars(bars.size());  // First signal bar
+    const size_t first_signal_bar = bar_index;
+    
+    strategy.backtest([&](const quantlab::strategy::StrategyResult& signal_result) {
+        QUANTLAB_PROFILE_HOT_SCOPE(EXECUTION);
+        engine.on_bar(market_event(bars, bar_index++));
+        route_signal(engine, signal_result, confidence_threshold);
+    });
+    
+    double final_price = bar_index > first_signal_bar ? bars.close[bar_index - 1] : fallback_price;
+    engine.calculate_final_metrics(final_price);
+    return final_price;
+}
+
+/**
+ * Tick-driven backtest: ticks in, bars built on the fly, signals per bar
+ *
+ * Ticks are pushed one at a time (or a page at a time) from any source - a
+ * TickSeries, a paged trades download, a file reader - and go through a
+ * BarAggregator. Every completed bar is fed to the engine as a MarketEvent
+ * followed by the strategy's signal on that bar, the same order
+ * run_strategy_backtest uses. The first warmup_bars bars only warm up the
+ * indicators and never reach the engine, so they add no flat marks to the
+ * metrics. Nothing per tick is kept, so memory does not grow with the
+ * tick count.
+ *
+ * finish() closes the bar in progress and marks the metrics at the last
+ * tick's price. Annualized metrics keep the engine's daily-mark convention,
+ * so compare intraday runs on total return and trade statistics.
+ */
+class TickBacktest {
+private:
+    quantlab::strategy::MeanReversionStrategy& strategy_;
+    BacktestEngine& engine_;
+    quantlab::core::BarAggregator aggregator_;
+    double confidence_threshold_;
+    size_t warmup_bars_;
+    
+    size_t ticks_ = 0;
+    size_t bars_ = 0;
+    double last_price_ = 0.0;
+    
+    void on_bar(const quantlab::core::AggregatedBar& bar) {
+        if (bars_++ < warmup_bars_) {
+            strategy_.warm_up_bar(bar.close);
+            return;
+        }
+        // Like run_strategy_backtest, the engine only sees bars from the first signal bar on
+        engine_.on_bar(MarketEvent{bar.timestamp_ns, bar.open, bar.high, bar.low, bar.close});
+        route_signal(engine_, strategy_.on_bar(bar.close), confidence_threshold_);
+    }
+    
+public:
+    static constexpr size_t DEFAULT_WARMUP_BARS = 20;  // Same cap MeanReversionStrategy::warmup_bars uses
+    
+    TickBacktest(quantlab::strategy::MeanReversionStrategy& strategy, BacktestEngine& engine,
+                 quantlab::core::BarAggregator aggregator, double confidence_threshold,
+                 size_t warmup_bars = DEFAULT_WARMUP_BARS)
+        : strategy_(strategy), engine_(engine), aggregator_(aggregator),
+          confidence_threshold_(confidence_threshold), warmup_bars_(warmup_bars) {
+        strategy_.reset_indicators();  // Clean run, like MeanReversionStrategy::backtest
+    }
+    
+    void on_tick(const quantlab::core::Tick& tick) {
+        ++ticks_;
+        last_price_ = tick.price;
+        if (auto bar = aggregator_.add(tick)) on_bar(*bar);
+    }
+    
+    void on_ticks(std::span<const quantlab::core::Tick> ticks) {
+        for (const auto& tick : ticks) on_tick(tick);
+    }
+    
+    // End of data: close the partial bar and finalize the engine's metrics; returns the mark price
+    double finish() {
+        if (auto bar = aggregator_.flush()) on_bar(*bar);
+        engine_.calculate_final_metrics(last_price_);
+        return last_price_;
+    }
+    
+    size_t ticks() const { return ticks_; }
+    size_t bars() const { return bars_; }
+};
+
+// Whole TickSeries through a TickBacktest; returns the price the metrics were marked at
+inline double run_tick_backtest(quantlab::strategy::MeanReversionStrategy& strategy, BacktestEngine& engine,
+                                const quantlab::core::TickSeries& ticks, quantlab::core::BarAggregator aggregator,
+                                double confidence_threshold) {
+    TickBacktest backtest(strategy, engine, aggregator, confidence_threshold);
+    for (const auto& tick : ticks) backtest.on_tick(tick);
+    return backtest.finish();
+}
+
+} // namespace quantlab::backtest
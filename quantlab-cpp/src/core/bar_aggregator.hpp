@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include "data_types.hpp"
+#include "time_utils.hpp"
+
+namespace quantlab::core {
+
+/**
+ * OHLCV bar built from ticks (fixed size, no ISO string)
+ */
+struct AggregatedBar {
+    int64_t timestamp_ns;    // Bar start: interval start for time bars, first tick for volume bars
+    int64_t last_tick_ns;    // Newest tick in the bar
+    double open;
+    double high;
+    double low;
+    double close;
+    int64_t volume;
+    uint32_t ticks;
+};
+
+/**
+ * Incremental tick -> bar aggregation in constant memory
+ *
+ *   TIME    bars cover [k * interval, (k + 1) * interval); a bar closes when the
+ *           first tick of a later interval arrives (intervals without ticks
+ *           produce no bar)
+ *   VOLUME  a bar closes on the tick that brings its volume to at least the
+ *           threshold (ticks are not split, so a bar can overshoot)
+ *
+ * Only the bar being built is held, so a day of tens of millions of ticks
+ * costs the same memory as a day of ten. Ticks must arrive in time order.
+ */
+class BarAggregator {
+public:
+    enum class Mode { TIME, VOLUME };
+
+    static BarAggregator time_bars(int64_t interval_ns) { return BarAggregator(Mode::TIME, interval_ns); }
+    static BarAggregator volume_bars(int64_t shares_per_bar) { return BarAggregator(Mode::VOLUME, shares_per_bar); }
+    static BarAggregator minute_bars(int minutes = 1) {
+        return time_bars(static_cast<int64_t>(minutes) * 60 * NANOS_PER_SECOND);
+    }
+
+    // Feed one tick; returns the bar it completed, if any
+    std::optional<AggregatedBar> add(const Tick& tick) {
+        if (mode_ == Mode::TIME) {
+            const int64_t start = interval_start(tick.timestamp_ns);
+            if (open_ && start != current_.timestamp_ns) {
+                AggregatedBar completed = current_;
+                begin(tick, start);
+                return completed;
+            }
+            if (!open_) {
+                begin(tick, start);
+            } else {
+                extend(tick);
+            }
+            return std::nullopt;
+        }
+
+        if (!open_) {
+            begin(tick, tick.timestamp_ns);
+        } else {
+            extend(tick);
+        }
+        if (current_.volume >= size_) {
+            open_ = false;
+            return current_;
+        }
+        return std::nullopt;
+    }
+
+    // Close the bar in progress (end of data); nullopt if there is none
+    std::optional<AggregatedBar> flush() {
+        if (!open_) return std::nullopt;
+        open_ = false;
+        return current_;
+    }
+
+    bool has_open_bar() const { return open_; }
+    Mode mode() const { return mode_; }
+    int64_t size() const { return size_; }  // Interval in ns (TIME) or shares per bar (VOLUME)
+
+private:
+    Mode mode_;
+    int64_t size_;
+    AggregatedBar current_{};
+    bool open_ = false;
+
+    BarAggregator(Mode mode, int64_t size) : mode_(mode), size_(std::max<int64_t>(1, size)) {}
+
+    // Floor division so pre-1970 timestamps land in the right interval
+    int64_t interval_start(int64_t timestamp_ns) const {
+        int64_t bucket = timestamp_ns / size_;
+        if (timestamp_ns % size_ < 0) --bucket;
+        return bucket * size_;
+    }
+
+    void begin(const Tick& tick, int64_t start) {
+        current_ = {start, tick.timestamp_ns, tick.price, tick.price, tick.price, tick.price, tick.quantity, 1};
+        open_ = true;
+    }
+
+    void extend(const Tick& tick) {
+        current_.last_tick_ns = tick.timestamp_ns;
+        current_.high = std::max(current_.high, tick.price);
+        current_.low = std::min(current_.low, tick.price);
+        current_.close = tick.price;
+        current_.volume += tick.quantity;
+        ++current_.ticks;
+    }
+};
+
+} // namespace quantlab::core
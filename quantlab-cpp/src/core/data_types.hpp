@@ -3,7 +3,9 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <span>
 #include <cassert>
+#include <algorithm>
 
 namespace quantlab::core {
 
@@ -25,6 +27,129 @@ struct Bar {
         : timestamp_ns(ts), open(o), high(h), low(l), close(c), volume(v) {}
 };
 
+/**
+ * Read-only columnar view over bar data
+ * 
+ * Each field is its own contiguous array, so a pass that only needs closes
+ * touches 8 bytes per bar instead of a whole Bar (with its heap-allocated
+ * string). Views are cheap to copy and slice; they never own memory.
+ */
+struct BarColumnsView {
+    std::span<const int64_t> timestamp_ns;
+    std::span<const double> open;
+    std::span<const double> high;
+    std::span<const double> low;
+    std::span<const double> close;
+    std::span<const int64_t> volume;
+    
+    size_t size() const { return close.size(); }
+    bool empty() const { return close.empty(); }
+    
+    // Bars [offset, offset + count) - count is clamped to what is available
+    BarColumnsView subview(size_t offset, size_t count = SIZE_MAX) const {
+        assert(offset <= size());
+        count = std::min(count, size() - offset);
+        return {timestamp_ns.subspan(offset, count), open.subspan(offset, count),
+                high.subspan(offset, count), low.subspan(offset, count),
+                close.subspan(offset, count), volume.subspan(offset, count)};
+    }
+    
+    // Materialize one row (without the ISO string)
+    Bar bar(size_t idx) const {
+        assert(idx < size());
+        return Bar(timestamp_ns[idx], open[idx], high[idx], low[idx], close[idx], volume[idx]);
+    }
+};
+
+/**
+ * Structure-of-arrays bar storage for the backtest hot path
+ * 
+ * ISO timestamp strings are kept in an optional side table only when asked
+ * for; the numeric columns never allocate per bar.
+ */
+class BarColumns {
+private:
+    std::vector<int64_t> timestamp_ns_;
+    std::vector<double> open_;
+    std::vector<double> high_;
+    std::vector<double> low_;
+    std::vector<double> close_;
+    std::vector<int64_t> volume_;
+    std::vector<std::string> iso_timestamps_;  // Side table, empty unless keep_iso_timestamps_
+    bool keep_iso_timestamps_ = false;
+    
+public:
+    BarColumns() = default;
+    explicit BarColumns(bool keep_iso_timestamps) : keep_iso_timestamps_(keep_iso_timestamps) {}
+    
+    explicit BarColumns(const std::vector<Bar>& bars, bool keep_iso_timestamps = false)
+        : keep_iso_timestamps_(keep_iso_timestamps) {
+        reserve(bars.size());
+        for (const auto& bar : bars) push_back(bar);
+    }
+    
+    void reserve(size_t capacity) {
+        timestamp_ns_.reserve(capacity);
+        open_.reserve(capacity);
+        high_.reserve(capacity);
+        low_.reserve(capacity);
+        close_.reserve(capacity);
+        volume_.reserve(capacity);
+        if (keep_iso_timestamps_) iso_timestamps_.reserve(capacity);
+    }
+    
+    void push_back(int64_t ts, double o, double h, double l, double c, int64_t v) {
+        timestamp_ns_.push_back(ts);
+        open_.push_back(o);
+        high_.push_back(h);
+        low_.push_back(l);
+        close_.push_back(c);
+        volume_.push_back(v);
+        if (keep_iso_timestamps_) iso_timestamps_.emplace_back();
+    }
+    
+    void push_back(const Bar& bar) {
+        push_back(bar.timestamp_ns, bar.open, bar.high, bar.low, bar.close, bar.volume);
+        if (keep_iso_timestamps_) iso_timestamps_.back() = bar.timestamp;
+    }
+    
+    void clear() {
+        timestamp_ns_.clear();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+        iso_timestamps_.clear();
+    }
+    
+    size_t size() const { return close_.size(); }
+    bool empty() const { return close_.empty(); }
+    
+    std::span<const int64_t> timestamp_ns() const { return timestamp_ns_; }
+    std::span<const double> open() const { return open_; }
+    std::span<const double> high() const { return high_; }
+    std::span<const double> low() const { return low_; }
+    std::span<const double> close() const { return close_; }
+    std::span<const int64_t> volume() const { return volume_; }
+    
+    bool has_iso_timestamps() const { return keep_iso_timestamps_; }
+    const std::string& iso_timestamp(size_t idx) const {
+        assert(keep_iso_timestamps_ && idx < iso_timestamps_.size());
+        return iso_timestamps_[idx];
+    }
+    
+    BarColumnsView view() const {
+        return {timestamp_ns_, open_, high_, low_, close_, volume_};
+    }
+    
+    Bar bar(size_t idx) const {
+        Bar row = view().bar(idx);
+        if (keep_iso_timestamps_) row.timestamp = iso_timestamps_[idx];
+        return row;
+    }
+};
+
 /**
  * Tick data for higher frequency operations
  */
@@ -122,9 +247,121 @@ public:
         if (n >= size()) return data_;
         return std::vector<T>(data_.end() - n, data_.end());
     }
+    
+    // Same window without the copy (valid until the next push_back)
+    std::span<const T> last(size_t n) const {
+        return std::span<const T>(data_).last(std::min(n, data_.size()));
+    }
+};
+
+/**
+ * Window of a RingTimeSeries: at most two contiguous segments, oldest first
+ *
+ * `first` runs up to the end of the ring's storage and `second` continues
+ * from its start; `second` is empty unless the window crosses the wrap
+ * point. Hot loops can run over both spans directly; operator[] and
+ * for_each() hide the split.
+ */
+template<typename T>
+struct RingWindow {
+    std::span<const T> first;
+    std::span<const T> second;
+    
+    size_t size() const { return first.size() + second.size(); }
+    bool empty() const { return size() == 0; }
+    
+    const T& operator[](size_t idx) const {
+        assert(idx < size());
+        return idx < first.size() ? first[idx] : second[idx - first.size()];
+    }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return second.empty() ? first.back() : second.back(); }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const T& item : first) fn(item);
+        for (const T& item : second) fn(item);
+    }
+};
+
+/**
+ * Fixed-capacity time series for long-running processes
+ *
+ * Storage is allocated once at construction; once full, each push_back
+ * overwrites the oldest element, so memory stays flat however long the
+ * process runs. Indexing is oldest first, like TimeSeries.
+ *
+ * Windows (last(n), window(offset, count)) are RingWindow views into the
+ * storage: no allocation, no copy. They stay valid until the next
+ * push_back() or clear().
+ */
+template<typename T>
+class RingTimeSeries {
+private:
+    std::vector<T> buffer_;
+    size_t head_ = 0;   // Physical index of the oldest element
+    size_t size_ = 0;
+    
+    // Physical index of logical element idx (idx <= capacity)
+    size_t physical(size_t idx) const {
+        size_t pos = head_ + idx;
+        return pos >= buffer_.size() ? pos - buffer_.size() : pos;
+    }
+    
+public:
+    explicit RingTimeSeries(size_t capacity) : buffer_(std::max<size_t>(1, capacity)) {}
+    
+    // Append; when full the oldest element is overwritten (returns true if one was)
+    bool push_back(const T& item) {
+        if (size_ < buffer_.size()) {
+            buffer_[physical(size_)] = item;
+            ++size_;
+            return false;
+        }
+        buffer_[head_] = item;
+        head_ = physical(1);
+        return true;
+    }
+    
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+    
+    const T& operator[](size_t idx) const {
+        assert(idx < size_);
+        return buffer_[physical(idx)];
+    }
+    
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == buffer_.size(); }
+    
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+    
+    // Elements [offset, offset + count) - count is clamped to what is available
+    RingWindow<T> window(size_t offset, size_t count = SIZE_MAX) const {
+        assert(offset <= size_);
+        count = std::min(count, size_ - offset);
+        const size_t begin = physical(offset);
+        const size_t contiguous = std::min(count, buffer_.size() - begin);
+        std::span<const T> storage(buffer_);
+        return {storage.subspan(begin, contiguous), storage.first(count - contiguous)};
+    }
+    
+    // Newest n elements (for rolling computations)
+    RingWindow<T> last(size_t n) const {
+        n = std::min(n, size_);
+        return window(size_ - n, n);
+    }
+    
+    RingWindow<T> all() const { return window(0, size_); }
 };
 
 using BarSeries = TimeSeries<Bar>;
 using TickSeries = TimeSeries<Tick>;
+using RingTickSeries = RingTimeSeries<Tick>;
 
 } // namespace quantlab::core
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace quantlab::core {
+
+/**
+ * Newline-delimited request/response server on a Unix domain socket
+ *
+ * Every line a client sends is one request. Requests from all connections
+ * go into one queue drained by a fixed pool of workers, so a client may
+ * pipeline many requests on one connection and get the responses back as
+ * they finish (possibly out of order - the protocol on top carries ids).
+ *
+ * handler(worker, request) runs on worker `worker` (0..workers-1), so
+ * callers can keep per-worker state without locking. Its return value is
+ * sent back as one line.
+ *
+ * run() blocks until stop() is called. stop() only sets a flag, so it is
+ * safe from a signal handler; queued requests are still answered. It
+ * refuses to start while another server answers on the same path, and the
+ * socket is only accessible to its owner (0600).
+ */
+class UnixLineServer {
+public:
+    using Handler = std::function<std::string(size_t worker, const std::string& request)>;
+
+private:
+    static constexpr int POLL_MS = 200;                    // How often blocked loops look at stopping_
+    static constexpr size_t MAX_REQUEST_BYTES = 1 << 20;   // A client sending a longer line is dropped
+
+    struct Connection {
+        int fd;
+        std::mutex write_mutex;  // Workers answering the same client take turns
+
+        explicit Connection(int descriptor) : fd(descriptor) {}
+        ~Connection() { ::close(fd); }
+
+        void send_line(const std::string& line) {
+            std::string framed = line + '\n';
+            std::lock_guard<std::mutex> lock(write_mutex);
+            size_t sent = 0;
+            while (sent < framed.size()) {
+                ssize_t n = ::send(fd, framed.data() + sent, framed.size() - sent, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return;  // Client went away; nothing left to do
+                sent += static_cast<size_t>(n);
+            }
+        }
+    };
+
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::string request;
+    };
+
+    std::string socket_path_;
+    size_t worker_count_;
+    Handler handler_;
+    std::atomic<bool> stopping_{false};
+
+    std::deque<Job> queue_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_ready_;
+
+    std::atomic<size_t> active_readers_{0};
+
+    void enqueue(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            queue_.push_back(std::move(job));
+        }
+        queue_ready_.notify_one();
+    }
+
+    void work(size_t index) {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                queue_ready_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+                if (queue_.empty()) return;  // Stopping and drained
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            try {
+                job.connection->send_line(handler_(index, job.request));
+            } catch (const std::exception& e) {
+                std::cerr << "❌ Request handler failed: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    // Split one client's byte stream into request lines
+    void read_requests(std::shared_ptr<Connection> connection) {
+        std::string buffer;
+        char chunk[4096];
+        while (!stopping_) {
+            pollfd ready{connection->fd, POLLIN, 0};
+            int events = ::poll(&ready, 1, POLL_MS);
+            if (events < 0 && errno == EINTR) continue;
+            if (events < 0) break;
+            if (events == 0) continue;
+
+            ssize_t n = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;  // Client closed the connection
+            buffer.append(chunk, static_cast<size_t>(n));
+
+            size_t start = 0;
+            for (size_t newline = buffer.find('\n'); newline != std::string::npos;
+                 newline = buffer.find('\n', start)) {
+                std::string line = buffer.substr(start, newline - start);
+                start = newline + 1;
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty()) enqueue({connection, std::move(line)});
+            }
+            buffer.erase(0, start);
+            if (buffer.size() > MAX_REQUEST_BYTES) {
+                std::cerr << "⚠️  Dropping client: request exceeds " << MAX_REQUEST_BYTES << " bytes" << std::endl;
+                break;
+            }
+        }
+        --active_readers_;
+    }
+
+public:
+    UnixLineServer(std::string socket_path, size_t workers, Handler handler)
+        : socket_path_(std::move(socket_path)), worker_count_(std::max<size_t>(1, workers)),
+          handler_(std::move(handler)) {}
+
+    // Serve until stop(); false if the socket could not be set up
+    bool run() {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socket_path_.size() >= sizeof(address.sun_path)) {
+            std::cerr << "❌ Error: Socket path too long: " << socket_path_ << std::endl;
+            return false;
+        }
+        std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+        int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "❌ Error: socket(): " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        // A socket that still accepts connections belongs to a running server: leave it alone.
+        // Anything else at the path is a stale socket left by a previous run.
+        if (::connect(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+            std::cerr << "❌ Error: Another server is already listening on " << socket_path_ << std::endl;
+            ::close(listen_fd);
+            return false;
+        }
+        ::close(listen_fd);
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "❌ Error: socket(): " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        ::unlink(socket_path_.c_str());
+        
+        // Owner-only before listen(), so no other local user can ever connect and submit work
+        if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::chmod(socket_path_.c_str(), 0600) != 0 || ::listen(listen_fd, 64) != 0) {
+            std::cerr << "❌ Error: Could not listen on " << socket_path_ << ": " << std::strerror(errno) << std::endl;
+            ::close(listen_fd);
+            return false;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count_);
+        for (size_t i = 0; i < worker_count_; ++i) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+
+        while (!stopping_) {
+            pollfd ready{listen_fd, POLLIN, 0};
+            int events = ::poll(&ready, 1, POLL_MS);
+            if (events <= 0) continue;  // Timeout or EINTR (e.g. the stop signal)
+
+            int client_fd = ::accept(listen_fd, nullptr, nullptr);
+            if (client_fd < 0) continue;
+            ++active_readers_;
+            std::thread(&UnixLineServer::read_requests, this, std::make_shared<Connection>(client_fd)).detach();
+        }
+
+        ::close(listen_fd);
+        ::unlink(socket_path_.c_str());
+
+        // Readers notice stopping_ within POLL_MS; workers drain what was already queued
+        while (active_readers_ > 0) std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS / 4));
+        {
+            // Workers test stopping_ under this lock - taking it means none can miss the wake-up
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+        }
+        queue_ready_.notify_all();
+        for (auto& worker : workers) worker.join();
+        return true;
+    }
+
+    void stop() { stopping_ = true; }
+
+    const std::string& socket_path() const { return socket_path_; }
+    size_t worker_count() const { return worker_count_; }
+};
+
+} // namespace quantlab::core
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace quantlab::core {
+
+// Default worker count: all hardware threads (at least one)
+inline size_t default_thread_count() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * Run fn(i) for every i in [0, count) on up to max_threads worker threads
+ *
+ * Workers pull the next index from a shared atomic counter, so uneven task
+ * costs balance themselves. The first exception thrown by any task is
+ * rethrown on the calling thread once all workers have stopped.
+ */
+template<typename Fn>
+void parallel_for(size_t count, size_t max_threads, Fn&& fn) {
+    if (count == 0) return;
+
+    size_t thread_count = std::min(count, std::max<size_t>(1, max_threads));
+    if (thread_count == 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error) first_error = std::current_exception();
+                next.store(count);  // Stop handing out work
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+    for (size_t t = 1; t < thread_count; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();  // The calling thread works too
+    for (auto& w : workers) w.join();
+
+    if (first_error) std::rethrow_exception(first_error);
+}
+
+} // namespace quantlab::core
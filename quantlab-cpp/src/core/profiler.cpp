@@ -0,0 +1,198 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <fmt/format.h>
+
+namespace quantlab::core::profiling {
+
+namespace {
+
+// Buffers outlive their threads (pool workers may exit before the report)
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::string trace_path;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+constexpr const char* PHASE_NAMES[PHASE_COUNT] = {
+    "throttle", "fetch", "parse", "cache", "indicators", "signals", "execution", "export"
+};
+
+constexpr const char* COUNTER_NAMES[COUNTER_COUNT] = {
+    "http_requests", "bytes_downloaded", "bars_decoded", "ticks_decoded", "bars_backtested", "fills", "rows_exported"
+};
+
+// Time blocked on the network or disk rather than computing
+bool is_io(Phase phase) {
+    return phase == Phase::THROTTLE || phase == Phase::FETCH || phase == Phase::CACHE || phase == Phase::EXPORT;
+}
+
+double ms(int64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+} // namespace
+
+const char* phase_name(Phase phase) {
+    return static_cast<size_t>(phase) < PHASE_COUNT ? PHASE_NAMES[static_cast<size_t>(phase)] : "unknown";
+}
+
+const char* counter_name(Counter counter) {
+    return static_cast<size_t>(counter) < COUNTER_COUNT ? COUNTER_NAMES[static_cast<size_t>(counter)] : "unknown";
+}
+
+ThreadBuffer* detail::register_thread() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->thread_index = static_cast<uint32_t>(reg.buffers.size());
+    reg.buffers.push_back(std::move(buffer));
+    return reg.buffers.back().get();
+}
+
+void start(const std::string& trace_path) {
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.trace_path = trace_path;
+    }
+    detail::origin_ns.store(detail::now_ns(), std::memory_order_relaxed);
+    detail::tracing.store(!trace_path.empty(), std::memory_order_relaxed);
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+bool start_from_env() {
+    const char* trace = std::getenv("QUANTLAB_TRACE");
+    const char* profile = std::getenv("QUANTLAB_PROFILE");
+    if (trace && *trace) {
+        start(trace);
+    } else if (profile && *profile && std::string(profile) != "0") {
+        start();
+    }
+    return enabled();
+}
+
+void finish() {
+    if (!enabled()) return;
+    detail::enabled.store(false, std::memory_order_relaxed);
+    report(std::cerr);
+
+    std::string trace_path;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        trace_path = reg.trace_path;
+    }
+    if (!trace_path.empty() && write_chrome_trace(trace_path)) {
+        std::cerr << "💾 Chrome trace written to " << trace_path << " (open in chrome://tracing or ui.perfetto.dev)"
+                  << std::endl;
+    }
+}
+
+void report(std::ostream& out) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::array<PhaseStats, PHASE_COUNT> phases{};
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    size_t active_threads = 0;
+    for (const auto& buffer : reg.buffers) {
+        bool active = false;
+        for (size_t p = 0; p < PHASE_COUNT; ++p) {
+            const PhaseStats& s = buffer->phases[p];
+            phases[p].calls += s.calls;
+            phases[p].total_ns += s.total_ns;
+            phases[p].self_ns += s.self_ns;
+            phases[p].max_ns = std::max(phases[p].max_ns, s.max_ns);
+            active |= s.calls > 0;
+        }
+        for (size_t c = 0; c < COUNTER_COUNT; ++c) counters[c] += buffer->counters[c];
+        active_threads += active;
+    }
+
+    const int64_t wall_ns = detail::now_ns() - detail::origin_ns.load(std::memory_order_relaxed);
+    int64_t io_ns = 0, compute_ns = 0;
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        (is_io(static_cast<Phase>(p)) ? io_ns : compute_ns) += phases[p].self_ns;
+    }
+    const int64_t instrumented_ns = std::max<int64_t>(1, io_ns + compute_ns);
+
+    // Self times are summed over threads, so with a worker pool the % column can exceed 100
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), "\n⏱️  Phase breakdown ({:.1f} ms wall, {} thread{})\n",
+                   ms(wall_ns), active_threads, active_threads == 1 ? "" : "s");
+    fmt::format_to(std::back_inserter(buffer), "  {:<11} {:>10} {:>12} {:>12} {:>8} {:>10}\n",
+                   "phase", "calls", "total ms", "self ms", "% wall", "max ms");
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        const PhaseStats& s = phases[p];
+        if (s.calls == 0) continue;
+        fmt::format_to(std::back_inserter(buffer), "  {:<11} {:>10} {:>12.2f} {:>12.2f} {:>7.1f}% {:>10.3f}\n",
+                       PHASE_NAMES[p], s.calls, ms(s.total_ns), ms(s.self_ns),
+                       100.0 * static_cast<double>(s.self_ns) / static_cast<double>(std::max<int64_t>(1, wall_ns)),
+                       ms(s.max_ns));
+    }
+    fmt::format_to(std::back_inserter(buffer), "  I/O (throttle, fetch, cache, export) {:.1f}% / compute {:.1f}% of instrumented time\n",
+                   100.0 * static_cast<double>(io_ns) / static_cast<double>(instrumented_ns),
+                   100.0 * static_cast<double>(compute_ns) / static_cast<double>(instrumented_ns));
+
+    bool any_counter = false;
+    for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+        if (counters[c] == 0) continue;
+        fmt::format_to(std::back_inserter(buffer), "{}{}={}", any_counter ? "  " : "  counters: ", COUNTER_NAMES[c],
+                       counters[c]);
+        any_counter = true;
+    }
+    if (any_counter) fmt::format_to(std::back_inserter(buffer), "\n");
+    out << std::string_view(buffer.data(), buffer.size()) << std::flush;
+}
+
+bool write_chrome_trace(const std::string& path) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "❌ Error: Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    // Complete ("X") events, microsecond timestamps; one tid per recording thread
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    uint64_t dropped = 0;
+    for (const auto& thread : reg.buffers) {
+        dropped += thread->dropped_events;
+        for (const TraceEvent& event : thread->trace) {
+            fmt::format_to(std::back_inserter(buffer),
+                           "{}\n{{\"name\":\"{}\",\"cat\":\"quantlab\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+                           "\"pid\":1,\"tid\":{},\"args\":{{\"depth\":{}}}}}",
+                           first ? "" : ",", phase_name(event.phase), static_cast<double>(event.start_ns) / 1e3,
+                           static_cast<double>(event.duration_ns) / 1e3, thread->thread_index, event.depth);
+            first = false;
+            if (buffer.size() > (1 << 20)) {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+    }
+    fmt::format_to(std::back_inserter(buffer), "\n],\"otherData\":{{\"dropped_events\":{}}}}}\n", dropped);
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!file) {
+        std::cerr << "❌ Error: Failed writing " << path << std::endl;
+        return false;
+    }
+    if (dropped > 0) {
+        std::cerr << "⚠️  Trace buffer full: " << dropped << " events dropped" << std::endl;
+    }
+    return true;
+}
+
+} // namespace quantlab::core::profiling
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Build-time switch: 0 compiles every QUANTLAB_PROFILE_* macro to nothing (CMake option QUANTLAB_PROFILING)
+#ifndef QUANTLAB_PROFILING
+#define QUANTLAB_PROFILING 0
+#endif
+
+namespace quantlab::core::profiling {
+
+/**
+ * Hot-path instrumentation: per-phase timers and counters
+ *
+ *   QUANTLAB_PROFILE_SCOPE(FETCH);           // times the enclosing block, also traced
+ *   QUANTLAB_PROFILE_HOT_SCOPE(INDICATORS);  // same, aggregate only (per-bar code)
+ *   QUANTLAB_PROFILE_COUNT(BARS_DECODED, n);
+ *
+ * Every thread records into its own buffer (no locks or atomics on the hot
+ * path); buffers are merged only when the report is built. Scopes nest:
+ * a phase's self time excludes the scopes opened inside it, so a backtest
+ * loop that calls the engine per bar shows strategy and execution time
+ * separately.
+ *
+ * Off at run time until start() (or start_from_env() with QUANTLAB_PROFILE=1
+ * or QUANTLAB_TRACE=<file>) - a disabled scope costs one relaxed load. With
+ * QUANTLAB_PROFILING=0 the macros expand to nothing at all.
+ *
+ * Reports are built from the buffers as they are: call report() /
+ * write_chrome_trace() once the worker threads have finished.
+ */
+enum class Phase : uint8_t {
+    THROTTLE,     // Waiting on the API rate limiter / 429 backoff
+    FETCH,        // HTTP round trips
+    PARSE,        // JSON decoding
+    CACHE,        // Bar cache / mapped file I/O
+    INDICATORS,   // Indicator updates and batch computes
+    SIGNALS,      // Strategy signal evaluation (backtest loop)
+    EXECUTION,    // Engine: orders, fills, marks, final metrics
+    EXPORT,       // Result files
+    COUNT
+};
+
+enum class Counter : uint8_t {
+    HTTP_REQUESTS,
+    BYTES_DOWNLOADED,
+    BARS_DECODED,
+    TICKS_DECODED,
+    BARS_BACKTESTED,
+    FILLS,
+    ROWS_EXPORTED,
+    COUNT
+};
+
+constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::COUNT);
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+constexpr size_t MAX_SCOPE_DEPTH = 32;            // Deeper scopes still count, without self-time accounting
+constexpr size_t MAX_TRACE_EVENTS = 1 << 20;      // Per thread; later events are counted as dropped
+
+const char* phase_name(Phase phase);
+const char* counter_name(Counter counter);
+
+struct PhaseStats {
+    uint64_t calls = 0;
+    int64_t total_ns = 0;   // Inclusive
+    int64_t self_ns = 0;    // Minus nested scopes
+    int64_t max_ns = 0;
+};
+
+struct TraceEvent {
+    Phase phase;
+    uint32_t depth;
+    int64_t start_ns;       // Since start()
+    int64_t duration_ns;
+};
+
+struct ThreadBuffer {
+    uint32_t thread_index = 0;
+    std::array<PhaseStats, PHASE_COUNT> phases{};
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    std::vector<TraceEvent> trace;
+    uint64_t dropped_events = 0;
+
+    // Open scopes: time spent in their children so far
+    std::array<int64_t, MAX_SCOPE_DEPTH> child_ns{};
+    uint32_t depth = 0;
+};
+
+namespace detail {
+inline std::atomic<bool> enabled{false};
+inline std::atomic<bool> tracing{false};
+inline std::atomic<int64_t> origin_ns{0};
+
+ThreadBuffer* register_thread();  // Once per thread, on its first enabled scope or count
+
+inline ThreadBuffer& thread_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) buffer = register_thread();
+    return *buffer;
+}
+
+inline int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace detail
+
+inline bool enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+// Turn recording on (clears nothing; call before the work to measure). trace_path empty = no trace.
+void start(const std::string& trace_path = "");
+// QUANTLAB_PROFILE=1 -> phase report; QUANTLAB_TRACE=<file> -> report plus Chrome trace. Returns enabled().
+bool start_from_env();
+// Stop recording, print the report to std::cerr and write the trace if one was requested
+void finish();
+
+// Profiles the lifetime of a main(): start_from_env() now, finish() on scope exit
+class Session {
+public:
+    Session() { start_from_env(); }
+    ~Session() { finish(); }
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+};
+
+// Per-phase table and counters over all threads
+void report(std::ostream& out);
+// chrome://tracing / Perfetto "Trace Event" JSON of every traced scope
+bool write_chrome_trace(const std::string& path);
+
+inline void count(Counter counter, uint64_t amount = 1) {
+    if (!enabled()) return;
+    detail::thread_buffer().counters[static_cast<size_t>(counter)] += amount;
+}
+
+class ScopedTimer {
+public:
+    ScopedTimer(Phase phase, bool traced) {
+        if (!enabled()) return;
+        buffer_ = &detail::thread_buffer();
+        phase_ = phase;
+        traced_ = traced;
+        if (buffer_->depth < MAX_SCOPE_DEPTH) buffer_->child_ns[buffer_->depth] = 0;
+        ++buffer_->depth;
+        start_ns_ = detail::now_ns();
+    }
+
+    ~ScopedTimer() {
+        if (!buffer_) return;
+        const int64_t elapsed = detail::now_ns() - start_ns_;
+        const uint32_t depth = --buffer_->depth;
+        const int64_t children = depth < MAX_SCOPE_DEPTH ? buffer_->child_ns[depth] : 0;
+        if (depth > 0 && depth - 1 < MAX_SCOPE_DEPTH) buffer_->child_ns[depth - 1] += elapsed;
+
+        PhaseStats& stats = buffer_->phases[static_cast<size_t>(phase_)];
+        ++stats.calls;
+        stats.total_ns += elapsed;
+        stats.self_ns += elapsed - children;
+        if (elapsed > stats.max_ns) stats.max_ns = elapsed;
+
+        if (traced_ && detail::tracing.load(std::memory_order_relaxed)) {
+            if (buffer_->trace.size() < MAX_TRACE_EVENTS) {
+                buffer_->trace.push_back({phase_, depth,
+                                          start_ns_ - detail::origin_ns.load(std::memory_order_relaxed), elapsed});
+            } else {
+                ++buffer_->dropped_events;
+            }
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    ThreadBuffer* buffer_ = nullptr;
+    Phase phase_ = Phase::COUNT;
+    bool traced_ = false;
+    int64_t start_ns_ = 0;
+};
+
+} // namespace quantlab::core::profiling
+
+#define QUANTLAB_PROFILE_CONCAT_INNER(a, b) a##b
+#define QUANTLAB_PROFILE_CONCAT(a, b) QUANTLAB_PROFILE_CONCAT_INNER(a, b)
+
+#if QUANTLAB_PROFILING
+#define QUANTLAB_PROFILE_SCOPE(phase) \
+    ::quantlab::core::profiling::ScopedTimer QUANTLAB_PROFILE_CONCAT(quantlab_profile_scope_, __LINE__)( \
+        ::quantlab::core::profiling::Phase::phase, true)
+#define QUANTLAB_PROFILE_HOT_SCOPE(phase) \
+    ::quantlab::core::profiling::ScopedTimer QUANTLAB_PROFILE_CONCAT(quantlab_profile_scope_, __LINE__)( \
+        ::quantlab::core::profiling::Phase::phase, false)
+#define QUANTLAB_PROFILE_COUNT(counter, amount) \
+    ::quantlab::core::profiling::count(::quantlab::core::profiling::Counter::counter, (amount))
+#else
+#define QUANTLAB_PROFILE_SCOPE(phase) ((void)0)
+#define QUANTLAB_PROFILE_HOT_SCOPE(phase) ((void)0)
+#define QUANTLAB_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace quantlab::core {
+
+/**
+ * Side of an executed trade
+ */
+enum class TradeAction : uint8_t {
+    BUY,
+    SELL
+};
+
+inline const char* to_string(TradeAction action) {
+    return action == TradeAction::BUY ? "BUY" : "SELL";
+}
+
+/**
+ * Why a strategy produced a signal
+ */
+enum class ReasonCode : uint8_t {
+    NONE,                  // No explanation recorded
+    NO_QUOTE,              // Live signal requested but no quote was available
+    HOLD,                  // No entry/exit condition met
+    HOLD_LOW_CONFIDENCE,   // Conditions scored below the confidence threshold
+    RSI_OVERSOLD,          // BUY: RSI below the oversold threshold with high confidence
+    RSI_OVERBOUGHT         // SELL: RSI above the overbought threshold with high confidence
+};
+
+/**
+ * Compact, allocation-free explanation attached to signals and trades
+ *
+ * Only the code and the numbers behind it are stored on the hot path; the
+ * human-readable text is built by to_string() when something is printed or
+ * exported. Trivially copyable, so signal and trade vectors never touch the
+ * heap per element.
+ */
+struct SignalReason {
+    ReasonCode code = ReasonCode::NONE;
+    double rsi = 0.0;          // RSI at signal time
+    double confidence = 0.0;   // Strategy confidence, 0.0 to 1.0
+    double threshold = 0.0;    // Confidence threshold in force (HOLD_LOW_CONFIDENCE)
+
+    std::string to_string() const {
+        switch (code) {
+            case ReasonCode::NO_QUOTE:
+                return "No quote data available";
+            case ReasonCode::HOLD:
+                return "HOLD";
+            case ReasonCode::HOLD_LOW_CONFIDENCE:
+                return "HOLD: Confidence=" + std::to_string((int)(confidence*100)) +
+                       "% (need >" + std::to_string((int)(threshold*100)) + "% for signal)";
+            case ReasonCode::RSI_OVERSOLD:
+                return "BUY: RSI=" + std::to_string((int)rsi) + " (oversold<30), High confidence=" +
+                       std::to_string((int)(confidence*100)) + "%";
+            case ReasonCode::RSI_OVERBOUGHT:
+                return "SELL: RSI=" + std::to_string((int)rsi) + " (overbought>70), High confidence=" +
+                       std::to_string((int)(confidence*100)) + "%";
+            case ReasonCode::NONE:
+                break;
+        }
+        return "";
+    }
+};
+
+} // namespace quantlab::core
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace quantlab::core::simd {
+
+/**
+ * Minimal portable SIMD layer for double-precision kernels
+ *
+ * One type (VecD) and a handful of element-wise ops, mapped to AVX2 (4 lanes),
+ * AArch64 NEON (2 lanes) or plain scalar code (1 lane). Every op is a single
+ * IEEE-754 correctly rounded instruction, so a vector lane produces exactly
+ * what the equivalent scalar expression would. Kernels process WIDTH elements
+ * per step and finish the tail with WIDTH-agnostic scalar code.
+ *
+ * The backend follows the compiler target (-march=native in Release builds).
+ */
+
+#if defined(__AVX2__)
+
+constexpr size_t WIDTH = 4;
+struct VecD { __m256d v; };
+struct MaskD { __m256d m; };
+
+inline VecD load(const double* p) { return {_mm256_loadu_pd(p)}; }
+inline void store(double* p, VecD a) { _mm256_storeu_pd(p, a.v); }
+inline VecD set1(double x) { return {_mm256_set1_pd(x)}; }
+inline VecD add(VecD a, VecD b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline VecD sub(VecD a, VecD b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline VecD mul(VecD a, VecD b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline VecD div(VecD a, VecD b) { return {_mm256_div_pd(a.v, b.v)}; }
+inline VecD sqrt(VecD a) { return {_mm256_sqrt_pd(a.v)}; }
+// max(a, b) with b returned when a == b (matches `a > b ? a : b`)
+inline VecD max(VecD a, VecD b) { return {_mm256_max_pd(a.v, b.v)}; }
+inline MaskD cmp_gt(VecD a, VecD b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskD cmp_eq(VecD a, VecD b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)}; }
+inline MaskD mask_and(MaskD a, MaskD b) { return {_mm256_and_pd(a.m, b.m)}; }
+// mask ? a : b per lane
+inline VecD select(MaskD mask, VecD a, VecD b) { return {_mm256_blendv_pd(b.v, a.v, mask.m)}; }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+constexpr size_t WIDTH = 2;
+struct VecD { float64x2_t v; };
+struct MaskD { uint64x2_t m; };
+
+inline VecD load(const double* p) { return {vld1q_f64(p)}; }
+inline void store(double* p, VecD a) { vst1q_f64(p, a.v); }
+inline VecD set1(double x) { return {vdupq_n_f64(x)}; }
+inline VecD add(VecD a, VecD b) { return {vaddq_f64(a.v, b.v)}; }
+inline VecD sub(VecD a, VecD b) { return {vsubq_f64(a.v, b.v)}; }
+inline VecD mul(VecD a, VecD b) { return {vmulq_f64(a.v, b.v)}; }
+inline VecD div(VecD a, VecD b) { return {vdivq_f64(a.v, b.v)}; }
+inline VecD sqrt(VecD a) { return {vsqrtq_f64(a.v)}; }
+inline MaskD cmp_gt(VecD a, VecD b) { return {vcgtq_f64(a.v, b.v)}; }
+inline MaskD cmp_eq(VecD a, VecD b) { return {vceqq_f64(a.v, b.v)}; }
+inline MaskD mask_and(MaskD a, MaskD b) { return {vandq_u64(a.m, b.m)}; }
+inline VecD select(MaskD mask, VecD a, VecD b) { return {vbslq_f64(mask.m, a.v, b.v)}; }
+// vmaxq_f64 treats -0.0 < +0.0; use compare+select to keep `a > b ? a : b` semantics
+inline VecD max(VecD a, VecD b) { return select(cmp_gt(a, b), a, b); }
+
+#else
+
+constexpr size_t WIDTH = 1;
+struct VecD { double v; };
+struct MaskD { bool m; };
+
+inline VecD load(const double* p) { return {*p}; }
+inline void store(double* p, VecD a) { *p = a.v; }
+inline VecD set1(double x) { return {x}; }
+inline VecD add(VecD a, VecD b) { return {a.v + b.v}; }
+inline VecD sub(VecD a, VecD b) { return {a.v - b.v}; }
+inline VecD mul(VecD a, VecD b) { return {a.v * b.v}; }
+inline VecD div(VecD a, VecD b) { return {a.v / b.v}; }
+inline VecD sqrt(VecD a) { return {std::sqrt(a.v)}; }
+inline VecD max(VecD a, VecD b) { return {a.v > b.v ? a.v : b.v}; }
+inline MaskD cmp_gt(VecD a, VecD b) { return {a.v > b.v}; }
+inline MaskD cmp_eq(VecD a, VecD b) { return {a.v == b.v}; }
+inline MaskD mask_and(MaskD a, MaskD b) { return {a.m && b.m}; }
+inline VecD select(MaskD mask, VecD a, VecD b) { return mask.m ? a : b; }
+
+#endif
+
+} // namespace quantlab::core::simd
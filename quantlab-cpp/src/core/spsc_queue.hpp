@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace quantlab::core {
+
+/**
+ * Bounded lock-free single-producer / single-consumer ring buffer
+ *
+ * One thread calls try_push(), one (other) thread calls try_pop(); neither
+ * ever blocks or allocates after construction. The producer and consumer
+ * indices live on separate cache lines, and each side keeps a private copy
+ * of the other's index so the shared line is only re-read when the queue
+ * looks full (producer) or empty (consumer).
+ *
+ * Indices grow without wrapping back; slot = index & mask, so the capacity
+ * is rounded up to a power of two.
+ */
+template<typename T>
+class SpscQueue {
+    static_assert(std::is_nothrow_move_assignable_v<T>, "a half-moved slot would corrupt the queue");
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots_;
+    size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};  // Next slot to write (producer)
+    size_t cached_tail_ = 0;                           // Producer's view of tail_
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};  // Next slot to read (consumer)
+    size_t cached_head_ = 0;                           // Consumer's view of head_
+
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) capacity <<= 1;
+        return capacity;
+    }
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots_(round_up_pow2(capacity)), mask_(slots_.size() - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer: false (item not taken) when the queue is full
+    bool try_push(T item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ == slots_.size()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ == slots_.size()) return false;
+        }
+        slots_[head & mask_] = std::move(item);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: nullopt when the queue is empty
+    std::optional<T> try_pop() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) return std::nullopt;
+        }
+        std::optional<T> item(std::move(slots_[tail & mask_]));
+        tail_.store(tail + 1, std::memory_order_release);
+        return item;
+    }
+
+    // Approximate when called while the other side is active. tail is read first: head only grows,
+    // so the head read after it is never behind it and the difference cannot wrap.
+    size_t size() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return head - tail;
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return slots_.size(); }
+};
+
+} // namespace quantlab::core
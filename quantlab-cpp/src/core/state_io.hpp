@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <span>
+#include <optional>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <filesystem>
+#include <type_traits>
+
+namespace quantlab::core {
+
+/**
+ * Append-only binary buffer for indicator / strategy snapshots
+ *
+ * Values are stored as raw native bytes (little-endian on every platform we
+ * run on), the same convention as the bar cache. Only trivially copyable
+ * values and double arrays are supported; anything richer is written field
+ * by field by its owner.
+ */
+class StateWriter {
+private:
+    std::vector<uint8_t> buffer_;
+
+public:
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "state fields must be trivially copyable");
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+    }
+
+    void write_bool(bool value) { write<uint8_t>(value ? 1 : 0); }
+
+    // Length-prefixed array
+    void write_doubles(std::span<const double> values) {
+        write<uint64_t>(values.size());
+        const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        buffer_.insert(buffer_.end(), bytes, bytes + values.size_bytes());
+    }
+
+    // Length-prefixed bytes
+    void write_string(const std::string& value) {
+        write<uint32_t>(static_cast<uint32_t>(value.size()));
+        buffer_.insert(buffer_.end(), value.begin(), value.end());
+    }
+
+    const std::vector<uint8_t>& buffer() const { return buffer_; }
+    std::vector<uint8_t> take() { return std::move(buffer_); }
+};
+
+/**
+ * Bounds-checked reader over a StateWriter buffer
+ *
+ * A read past the end fails and leaves the reader failed, so callers can read
+ * a whole record and check ok() once.
+ */
+class StateReader {
+private:
+    std::span<const uint8_t> data_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+
+public:
+    explicit StateReader(std::span<const uint8_t> data) : data_(data) {}
+
+    template<typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "state fields must be trivially copyable");
+        if (!ok_ || data_.size() - offset_ < sizeof(T)) return ok_ = false;
+        std::memcpy(&value, data_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+    bool read_bool(bool& value) {
+        uint8_t byte = 0;
+        if (!read(byte) || byte > 1) return ok_ = false;
+        value = byte == 1;
+        return true;
+    }
+
+    bool read_doubles(std::vector<double>& values) {
+        uint64_t count = 0;
+        if (!read(count) || count > (data_.size() - offset_) / sizeof(double)) return ok_ = false;
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), data_.data() + offset_, values.size() * sizeof(double));
+        offset_ += values.size() * sizeof(double);
+        return true;
+    }
+
+    bool read_string(std::string& value) {
+        uint32_t length = 0;
+        if (!read(length) || length > data_.size() - offset_) return ok_ = false;
+        value.assign(reinterpret_cast<const char*>(data_.data() + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+    // Mark the record as invalid (e.g. a field that does not match the reader's configuration)
+    bool fail() { return ok_ = false; }
+
+    bool ok() const { return ok_; }
+    bool at_end() const { return offset_ == data_.size(); }
+};
+
+// Write a snapshot atomically: a temp file next to `path` is renamed over it
+inline bool write_state_file(const std::string& path, std::span<const uint8_t> blob) {
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(reinterpret_cast<const char*>(blob.data()), blob.size())) {
+            std::cerr << "❌ Error: Could not write state file " << temp_path << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::cerr << "❌ Error: Could not replace state file " << path << ": " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Whole snapshot file, or nullopt if it does not exist / cannot be read
+inline std::optional<std::vector<uint8_t>> read_state_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::nullopt;
+    std::vector<uint8_t> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (file.bad()) return std::nullopt;
+    return blob;
+}
+
+} // namespace quantlab::core
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <cassert>
+
+namespace quantlab::core {
+
+// Dense symbol id: 0, 1, 2, ... in registration order, usable as a vector index
+using SymbolId = uint32_t;
+
+/**
+ * Two-way mapping between ticker strings and dense ids
+ *
+ * Hot loops index plain vectors by SymbolId; the strings are only looked up
+ * when loading data or printing results.
+ */
+class SymbolTable {
+private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, SymbolId> ids_;
+
+public:
+    // Id for a symbol, assigning the next id on first sight
+    SymbolId intern(const std::string& symbol) {
+        auto [it, inserted] = ids_.try_emplace(symbol, static_cast<SymbolId>(names_.size()));
+        if (inserted) names_.push_back(symbol);
+        return it->second;
+    }
+
+    std::optional<SymbolId> find(const std::string& symbol) const {
+        auto it = ids_.find(symbol);
+        if (it == ids_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    const std::string& name(SymbolId id) const {
+        assert(id < names_.size());
+        return names_[id];
+    }
+
+    size_t size() const { return names_.size(); }
+    const std::vector<std::string>& names() const { return names_; }
+};
+
+} // namespace quantlab::core
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <ctime>
+
+namespace quantlab::core {
+
+/**
+ * Calendar helpers for UTC epoch days and ISO-8601 timestamps
+ *
+ * Epoch days (days since 1970-01-01) are used as compact, sortable keys for
+ * date ranges; integer arithmetic keeps them exact and cheap to compare.
+ */
+
+constexpr int64_t NANOS_PER_SECOND = 1'000'000'000LL;
+constexpr int64_t SECONDS_PER_DAY = 86'400LL;
+constexpr int64_t NANOS_PER_DAY = SECONDS_PER_DAY * NANOS_PER_SECOND;
+
+// Howard Hinnant's days_from_civil: proleptic Gregorian date -> days since epoch
+constexpr int32_t days_from_civil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+// Inverse of days_from_civil
+constexpr void civil_from_days(int32_t z, int& year, unsigned& month, unsigned& day) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(yoe) + era * 400 + (month <= 2);
+}
+
+// Floor division so pre-1970 timestamps map to the correct day
+constexpr int32_t epoch_day_from_nanoseconds(int64_t timestamp_ns) {
+    int64_t day = timestamp_ns / NANOS_PER_DAY;
+    if (timestamp_ns % NANOS_PER_DAY < 0) --day;
+    return static_cast<int32_t>(day);
+}
+
+inline int32_t today_epoch_day() {
+    return static_cast<int32_t>(std::time(nullptr) / SECONDS_PER_DAY);
+}
+
+// "YYYY-MM-DD" -> epoch day (returns 0 on malformed input)
+inline int32_t epoch_day_from_date(std::string_view date) {
+    int year = 0;
+    unsigned month = 0, day = 0;
+    std::string buf(date.substr(0, 10));
+    if (std::sscanf(buf.c_str(), "%d-%u-%u", &year, &month, &day) != 3) {
+        return 0;
+    }
+    return days_from_civil(year, month, day);
+}
+
+// epoch day -> "YYYY-MM-DD" (format accepted by the Alpaca start/end parameters)
+inline std::string date_from_epoch_day(int32_t epoch_day) {
+    int year;
+    unsigned month, day;
+    civil_from_days(epoch_day, year, month, day);
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", year, month, day);
+    return buf;
+}
+
+/**
+ * Parse RFC-3339 / ISO-8601 timestamps such as "2024-01-02T05:00:00Z",
+ * "2024-01-02T14:30:00.123456789Z" or "2024-01-02T09:30:00-05:00".
+ * Returns 0 when the string cannot be parsed.
+ */
+inline int64_t parse_iso8601_to_nanoseconds(std::string_view ts) {
+    auto digits = [&](size_t pos, size_t count, int& out) {
+        if (pos + count > ts.size()) return false;
+        int value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (ts[i] < '0' || ts[i] > '9') return false;
+            value = value * 10 + (ts[i] - '0');
+        }
+        out = value;
+        return true;
+    };
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!digits(0, 4, year) || !digits(5, 2, month) || !digits(8, 2, day)) {
+        return 0;
+    }
+
+    size_t pos = 10;
+    if (pos < ts.size() && (ts[pos] == 'T' || ts[pos] == ' ')) {
+        if (!digits(11, 2, hour) || !digits(14, 2, minute) || !digits(17, 2, second)) {
+            return 0;
+        }
+        pos = 19;
+    }
+
+    // Fractional seconds, up to nanosecond precision
+    int64_t fraction_ns = 0;
+    if (pos < ts.size() && ts[pos] == '.') {
+        ++pos;
+        int64_t scale = 100'000'000LL;
+        while (pos < ts.size() && ts[pos] >= '0' && ts[pos] <= '9') {
+            fraction_ns += (ts[pos] - '0') * scale;
+            scale /= 10;
+            ++pos;
+        }
+    }
+
+    // Timezone designator: 'Z' or +hh:mm / -hh:mm
+    int64_t offset_seconds = 0;
+    if (pos < ts.size() && (ts[pos] == '+' || ts[pos] == '-')) {
+        int off_h = 0, off_m = 0;
+        if (digits(pos + 1, 2, off_h) && digits(pos + 4, 2, off_m)) {
+            offset_seconds = (off_h * 3600 + off_m * 60) * (ts[pos] == '-' ? -1 : 1);
+        }
+    }
+
+    int64_t days = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    int64_t seconds = days * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second - offset_seconds;
+    return seconds * NANOS_PER_SECOND + fraction_ns;
+}
+
+// epoch nanoseconds -> "YYYY-MM-DDTHH:MM:SSZ" (same shape the Alpaca API returns)
+inline std::string format_iso8601(int64_t timestamp_ns) {
+    int32_t epoch_day = epoch_day_from_nanoseconds(timestamp_ns);
+    int64_t second_of_day = (timestamp_ns - epoch_day * NANOS_PER_DAY) / NANOS_PER_SECOND;
+
+    int year;
+    unsigned month, day;
+    civil_from_days(epoch_day, year, month, day);
+
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%04d-%02u-%02uT%02d:%02d:%02dZ", year, month, day,
+                  static_cast<int>(second_of_day / 3600),
+                  static_cast<int>((second_of_day / 60) % 60),
+                  static_cast<int>(second_of_day % 60));
+    return buf;
+}
+
+} // namespace quantlab::core
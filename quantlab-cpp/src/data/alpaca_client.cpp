@@ -1,4 +1,8 @@
 #include "alpaca_client.hpp"
+#include "rate_limiter.hpp"
+#include "bar_json_decoder.hpp"
+#include "../core/time_utils.hpp"
+#include "../core/profiler.hpp"
 #include <iostream>
 #include <cpr/cpr.h>
 #include <chrono>
@@ -6,9 +10,14 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <random>
 
 namespace quantlab::data {
 
+int32_t AlpacaClient::aggregated_window_first_day(int total_days) {
+    return quantlab::core::today_epoch_day() - HISTORY_LAG_DAYS - total_days + 1;
+}
+
 // ENHANCED: MULTI-MINUTE RATE-LIMITED AGGREGATION SYSTEM
 std::vector<quantlab::core::Bar> AlpacaClient::get_aggregated_historical_bars(
     const std::string& symbol,
@@ -16,54 +25,84 @@ std::vector<quantlab::core::Bar> AlpacaClient::get_aggregated_historical_bars(
     int total_days,
     int days_per_call) {
     
-    // Calculate rate limiting for API calls
-    const int MAX_CALLS_PER_MINUTE = 200; // Free plan limit
-    int total_minutes = (total_days + MAX_CALLS_PER_MINUTE - 1) / MAX_CALLS_PER_MINUTE;
-    
-    std::vector<quantlab::core::Bar> all_bars;
-    int calls_in_current_minute = 0;
-    auto minute_start = std::chrono::steady_clock::now();
-    
-    // Start from 15 days ago to avoid recent SIP data restrictions
-    int start_offset = 15;
-    for (int day_offset = start_offset; day_offset < total_days + start_offset; ++day_offset) {
-        // Check if we need to wait for next minute
-        if (calls_in_current_minute >= MAX_CALLS_PER_MINUTE) {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - minute_start).count();
-            
-            if (elapsed < 60) {
-                int wait_time = 60 - elapsed;
-                std::this_thread::sleep_for(std::chrono::seconds(wait_time));
+    // Window ends HISTORY_LAG_DAYS ago to avoid recent SIP data restrictions
+    const int32_t first_day = aggregated_window_first_day(total_days);
+    const int32_t last_day = first_day + total_days - 1;
+    
+    // Only the days the cache has never seen go to the network
+    std::vector<DayRange> missing = bar_cache_
+        ? bar_cache_->missing_ranges(symbol, timeframe, first_day, last_day)
+        : std::vector<DayRange>{{first_day, last_day}};
+    
+    int days_to_fetch = 0;
+    for (const auto& range : missing) {
+        days_to_fetch += range.last_day - range.first_day + 1;
+    }
+    if (bar_cache_) {
+        std::cout << "💾 Bar cache: " << (total_days - days_to_fetch) << "/" << total_days
+                  << " days cached, fetching " << days_to_fetch << std::endl;
+    }
+    
+    std::vector<quantlab::core::Bar> fetched_bars;  // Only used when the cache is disabled
+    
+    auto store = [&](int32_t range_first, int32_t range_last, const quantlab::core::BarColumns& bars) {
+        if (bar_cache_) {
+            bar_cache_->append(symbol, timeframe, range_first, range_last, bars.view());
+        } else {
+            for (size_t i = 0; i < bars.size(); ++i) {
+                fetched_bars.push_back(bars.bar(i));
+                fetched_bars.back().timestamp = quantlab::core::format_iso8601(fetched_bars.back().timestamp_ns);
             }
+        }
+    };
+    
+    // Request pacing is handled by the shared token bucket inside make_request
+    for (const auto& range : missing) {
+        // RANGE mode: the whole gap in as few paginated requests as possible
+        if (fetch_mode_ == FetchMode::RANGE) {
+            auto range_bars = fetch_bars(symbol, timeframe,
+                                         quantlab::core::date_from_epoch_day(range.first_day),
+                                         quantlab::core::date_from_epoch_day(range.last_day));
             
-            // Reset for new minute
-            calls_in_current_minute = 0;
-            minute_start = std::chrono::steady_clock::now();
+            if (range_bars) {
+                store(range.first_day, range.last_day, *range_bars);
+                continue;
+            }
+            std::cerr << "⚠️  Range request failed for " << symbol << ", falling back to per-day requests" << std::endl;
         }
         
-        // Calculate the specific date for this offset
-        std::string date_str = get_date_string(day_offset);
-        
-        // Make single-day call with specific date range
-        auto daily_bars = get_historical_bars(symbol, timeframe, date_str, date_str);
-        
-        if (!daily_bars.empty()) {
-            all_bars.insert(all_bars.end(), daily_bars.begin(), daily_bars.end());
+        // PER_DAY mode (and fallback): one request per days_per_call calendar days
+        const int step = std::max(1, days_per_call);
+        for (int32_t day = range.first_day; day <= range.last_day; day += step) {
+            // Make short-window call with specific date range
+            int32_t chunk_last = std::min(range.last_day, day + step - 1);
+            auto daily_bars = fetch_bars(symbol, timeframe,
+                                         quantlab::core::date_from_epoch_day(day),
+                                         quantlab::core::date_from_epoch_day(chunk_last));
+            
+            if (!daily_bars) {
+                continue;  // Failed request - leave the days uncached so the next run retries them
+            }
+            store(day, chunk_last, *daily_bars);
         }
-        
-        calls_in_current_minute++;
     }
     
+    if (!bar_cache_) {
+        // Fallback requests can land out of order - restore chronological order
+        std::stable_sort(fetched_bars.begin(), fetched_bars.end(),
+                         [](const quantlab::core::Bar& a, const quantlab::core::Bar& b) {
+                             return a.timestamp_ns < b.timestamp_ns;
+                         });
+    }
+    
+    // Bars come back chronological (oldest first, newest last) for backtesting
+    std::vector<quantlab::core::Bar> all_bars = bar_cache_
+        ? bar_cache_->load(symbol, timeframe, first_day, last_day)
+        : std::move(fetched_bars);
+    
     // Debug: Show data collection summary
     std::cout << "Collected " << all_bars.size() << " bars from " << total_days << " day period" << std::endl;
     
-    // CRITICAL FIX: Reverse the data to be chronological (oldest first, newest last)
-    // Current order: newest -> oldest (wrong for backtesting)
-    // Required order: oldest -> newest (correct for backtesting)
-    std::reverse(all_bars.begin(), all_bars.end());
-    std::cout << "🔄 Data reordered chronologically (oldest to newest) for proper backtesting" << std::endl;
-    
     return all_bars;
 }
 
@@ -83,6 +122,10 @@ std::string AlpacaClient::get_date_string(int days_ago) {
     return oss.str();
 }
 
+int64_t AlpacaClient::parse_iso8601_to_nanoseconds(const std::string& iso_timestamp) {
+    return quantlab::core::parse_iso8601_to_nanoseconds(iso_timestamp);
+}
+
 std::string AlpacaClient::make_request(const std::string& endpoint, bool use_market_data_api) {
     // Choose the correct base URL
     std::string base_url = use_market_data_api ? market_data_base_url_ : trading_base_url_;
@@ -92,23 +135,39 @@ std::string AlpacaClient::make_request(const std::string& endpoint, bool use_mar
     const int max_retries = 5;
     const int base_delay_ms = 1000; // 1 second
 
+    // Jitter source; one per thread so concurrent loaders don't share rand() state
+    thread_local std::mt19937 jitter_rng(std::random_device{}());
+    
     while (retry_count <= max_retries) {
-        auto response = cpr::Get(
-            cpr::Url{url}, 
-            cpr::Header{
-                {"APCA-API-KEY-ID", api_key_}, 
-                {"APCA-API-SECRET-KEY", api_secret_}
-            }
-        );
+        // Every request in the process draws from the same token bucket
+        {
+            QUANTLAB_PROFILE_SCOPE(THROTTLE);
+            alpaca_rate_limiter().acquire();
+        }
+        
+        cpr::Response response;
+        {
+            QUANTLAB_PROFILE_SCOPE(FETCH);
+            response = cpr::Get(
+                cpr::Url{url}, 
+                cpr::Header{
+                    {"APCA-API-KEY-ID", api_key_}, 
+                    {"APCA-API-SECRET-KEY", api_secret_}
+                }
+            );
+        }
+        QUANTLAB_PROFILE_COUNT(HTTP_REQUESTS, 1);
+        QUANTLAB_PROFILE_COUNT(BYTES_DOWNLOADED, response.text.size());
 
         if (response.status_code == 200) {
             return response.text;
         } else if (response.status_code == 429) {
             // Handle rate limit with exponential backoff and jitter
             int backoff_time = base_delay_ms * (1 << retry_count); // Exponential backoff
-            backoff_time += rand() % 500; // Add jitter (0-500ms)
+            backoff_time += jitter_rng() % 500; // Add jitter (0-500ms)
             std::cerr << "Rate limit hit. Retrying in " << backoff_time << " ms..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::milliseconds(backoff_time));
+            // Hold back every in-flight request, not just this one
+            alpaca_rate_limiter().pause(std::chrono::milliseconds(backoff_time));
             retry_count++;
         } else {
             std::cerr << "HTTP Error " << response.status_code << " for URL: " << url << std::endl;
@@ -140,6 +199,31 @@ std::vector<quantlab::core::Bar> AlpacaClient::get_historical_bars(
     const std::string& start_date,
     const std::string& end_date) {
     
+    auto columns = get_historical_bar_columns(symbol, timeframe, start_date, end_date);
+    std::vector<quantlab::core::Bar> bars;
+    bars.reserve(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        bars.push_back(columns.bar(i));
+        bars.back().timestamp = quantlab::core::format_iso8601(bars.back().timestamp_ns);
+    }
+    return bars;
+}
+
+quantlab::core::BarColumns AlpacaClient::get_historical_bar_columns(
+    const std::string& symbol,
+    const std::string& timeframe,
+    const std::string& start_date,
+    const std::string& end_date) {
+    
+    return fetch_bars(symbol, timeframe, start_date, end_date).value_or(quantlab::core::BarColumns{});
+}
+
+std::optional<quantlab::core::BarColumns> AlpacaClient::fetch_bars(
+    const std::string& symbol,
+    const std::string& timeframe,
+    const std::string& start_date,
+    const std::string& end_date) {
+    
     // Request historical bars for symbol
     
     // Build endpoint with proper date parameters (base URL already has /v2)
@@ -152,44 +236,81 @@ std::vector<quantlab::core::Bar> AlpacaClient::get_historical_bars(
     if (!end_date.empty()) {
         endpoint += "&end=" + end_date;
     }
+    endpoint += "&limit=" + std::to_string(MAX_BARS_PER_PAGE);
     
-    std::string response = make_request(endpoint, true); // Use market data API
-    
-    if (response.empty()) {
-        return {};
-    }
+    quantlab::core::BarColumns bars;
+    std::string page_token;
     
-    // Parse the JSON response
-    try {
-        auto json_data = nlohmann::json::parse(response);
-        
-        if (!json_data.contains("bars") || json_data["bars"].empty()) {
-            return {};
+    // Follow next_page_token until the server reports the range is exhausted
+    do {
+        std::string page_endpoint = endpoint;
+        if (!page_token.empty()) {
+            page_endpoint += "&page_token=" + cpr::util::urlEncode(page_token);  // Base64: may hold + / =
         }
         
-        std::vector<quantlab::core::Bar> bars;
+        std::string response = make_request(page_endpoint, true); // Use market data API
         
-        for (const auto& bar_json : json_data["bars"]) {
-            quantlab::core::Bar bar;
-            bar.timestamp = bar_json["t"];
-            bar.open = bar_json["o"];
-            bar.high = bar_json["h"];
-            bar.low = bar_json["l"];
-            bar.close = bar_json["c"];
-            bar.volume = bar_json["v"];
-            
-            bars.push_back(bar);
+        if (response.empty()) {
+            return std::nullopt;
         }
         
-        // Return the bars
+        // Decode the page straight into the columns
+        auto page = decode_bar_page(response, bars);
+        if (!page.ok) {
+            std::cerr << "Raw response: " << response.substr(0, 200) << "..." << std::endl;
+            return std::nullopt;
+        }
+        if (page.skipped > 0) {
+            std::cerr << "⚠️  Skipped " << page.skipped << " incomplete bars for " << symbol << std::endl;
+        }
+        page_token = std::move(page.next_page_token);
+    } while (!page_token.empty());
+    
+    // Return the bars
+    
+    return bars;
+}
+
+std::optional<size_t> AlpacaClient::for_each_trade_page(
+    const std::string& symbol,
+    const std::string& start,
+    const std::string& end,
+    const std::function<void(std::span<const quantlab::core::Tick>)>& on_page) {
+    
+    // RFC-3339 offsets ("+05:00") must not reach the server as spaces
+    std::string endpoint = "/stocks/" + symbol + "/trades?start=" + cpr::util::urlEncode(start) +
+                           "&end=" + cpr::util::urlEncode(end) + "&limit=" + std::to_string(MAX_TRADES_PER_PAGE);
+    
+    std::vector<quantlab::core::Tick> page_ticks;  // Reused: capacity settles at one page
+    std::string page_token;
+    size_t delivered = 0;
+    
+    do {
+        std::string page_endpoint = endpoint;
+        if (!page_token.empty()) {
+            page_endpoint += "&page_token=" + cpr::util::urlEncode(page_token);  // Base64: may hold + / =
+        }
         
-        return bars;
+        std::string response = make_request(page_endpoint, true);
+        if (response.empty()) {
+            return std::nullopt;
+        }
         
-    } catch (const std::exception& e) {
-        std::cerr << "❌ JSON parsing error: " << e.what() << std::endl;
-        std::cerr << "Raw response: " << response.substr(0, 200) << "..." << std::endl;
-        return {};
-    }
+        page_ticks.clear();
+        auto page = decode_trade_page(response, page_ticks);
+        if (!page.ok) {
+            std::cerr << "Raw response: " << response.substr(0, 200) << "..." << std::endl;
+            return std::nullopt;
+        }
+        if (page.skipped > 0) {
+            std::cerr << "⚠️  Skipped " << page.skipped << " incomplete trades for " << symbol << std::endl;
+        }
+        on_page(page_ticks);
+        delivered += page_ticks.size();
+        page_token = std::move(page.next_page_token);
+    } while (!page_token.empty());
+    
+    return delivered;
 }
 
 // METHOD 3: Get Latest Quote
@@ -204,6 +325,7 @@ std::optional<quantlab::core::Quote> AlpacaClient::get_latest_quote(const std::s
     }
     
     try {
+        QUANTLAB_PROFILE_SCOPE(PARSE);
         auto json_data = nlohmann::json::parse(response);
         
         if (!json_data.contains("quote")) {
@@ -3,23 +3,50 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
+#include <functional>
+#include <span>
 #include <cstdlib>  // for getenv
 #include <stdexcept>
 #include <nlohmann/json.hpp>
 #include "../core/data_types.hpp"
+#include "bar_cache.hpp"
+#include "data_source.hpp"
 
 namespace quantlab::data {
 
-class AlpacaClient {
+/**
+ * How get_aggregated_historical_bars talks to the bars endpoint
+ */
+enum class FetchMode {
+    RANGE,   // Whole date window per request, following next_page_token
+    PER_DAY  // One request per calendar day (legacy path, also the fallback)
+};
+
+class AlpacaClient : public DataSource {
 private:
     std::string trading_base_url_;     // For account/trading operations
     std::string market_data_base_url_; // For market data (prices, bars)
     std::string api_key_;
     std::string api_secret_;
     
+    // Persistent bar store consulted before any historical request (null = disabled)
+    std::unique_ptr<BarCache> bar_cache_;
+    
     // HTTP helper methods
     std::string make_request(const std::string& endpoint, bool use_market_data_api = false);
     
+    FetchMode fetch_mode_ = FetchMode::RANGE;
+    
+    // Fetch all pages for a date range; nullopt on HTTP/parse failure (vs. empty = no bars)
+    // Pages are SAX-decoded straight into the columns (see decode_bar_page)
+    std::optional<quantlab::core::BarColumns> fetch_bars(
+        const std::string& symbol,
+        const std::string& timeframe,
+        const std::string& start_date,
+        const std::string& end_date
+    );
+    
     // Utility functions
     int64_t parse_iso8601_to_nanoseconds(const std::string& iso_timestamp);
     std::string get_date_string(int days_ago = 0);
@@ -47,10 +74,33 @@ public:
         
         // Market data API uses different base URL
         market_data_base_url_ = "https://data.alpaca.markets/v2";
+        
+        // Optional bar cache directory; set QUANTLAB_CACHE_DIR="" to disable caching
+        const char* cache_dir = std::getenv("QUANTLAB_CACHE_DIR");
+        std::string cache_path = cache_dir ? cache_dir : ".quantlab_cache";
+        if (!cache_path.empty()) {
+            bar_cache_ = std::make_unique<BarCache>(cache_path);
+        }
     }
     
+    // Historical requests stop this many days before today to avoid recent SIP data restrictions
+    static constexpr int HISTORY_LAG_DAYS = 15;
+    
+    // Largest page the bars endpoint will return
+    static constexpr int MAX_BARS_PER_PAGE = 10000;
+    static constexpr int MAX_TRADES_PER_PAGE = 10000;
+    
+    // First UTC epoch day of the window get_aggregated_historical_bars(total_days) covers
+    static int32_t aggregated_window_first_day(int total_days);
+    
+    // Bar store behind the historical requests (null when caching is disabled)
+    BarCache* bar_cache() const override { return bar_cache_.get(); }
+    
+    void set_fetch_mode(FetchMode mode) { fetch_mode_ = mode; }
+    FetchMode get_fetch_mode() const { return fetch_mode_; }
+    
     // Market data methods
-    bool test_connection();
+    bool test_connection() override;
     
     std::vector<quantlab::core::Bar> get_historical_bars(
         const std::string& symbol,
@@ -59,15 +109,35 @@ public:
         const std::string& end_date = ""
     );
     
-    std::optional<quantlab::core::Quote> get_latest_quote(const std::string& symbol);
+    // Same request without materializing Bar rows or ISO strings
+    quantlab::core::BarColumns get_historical_bar_columns(
+        const std::string& symbol,
+        const std::string& timeframe = "1Day",
+        const std::string& start_date = "",
+        const std::string& end_date = ""
+    ) override;
+    
+    std::optional<quantlab::core::Quote> get_latest_quote(const std::string& symbol) override;
+    
+    // Historical trades in [start, end] (dates or RFC-3339 times) as Ticks, handed over one decoded
+    // page at a time so memory stays at one page however many trades the range holds.
+    // Returns the number of ticks delivered; nullopt on HTTP / parse failure.
+    std::optional<size_t> for_each_trade_page(
+        const std::string& symbol,
+        const std::string& start,
+        const std::string& end,
+        const std::function<void(std::span<const quantlab::core::Tick>)>& on_page
+    );
     
     // ENHANCED: Multi-minute rate-limited aggregation system
+    // Serves cached days from the bar cache and fetches the gaps according to fetch_mode_
+    // (days_per_call sets the request window in PER_DAY mode)
     std::vector<quantlab::core::Bar> get_aggregated_historical_bars(
         const std::string& symbol,
         const std::string& timeframe = "1Day",
         int total_days = 250,
         int days_per_call = 1
-    );
+    ) override;
 };
 
 } // namespace quantlab::data
\ No newline at end of file
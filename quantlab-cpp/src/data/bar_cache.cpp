@@ -0,0 +1,227 @@
+#include "bar_cache.hpp"
+#include "../core/time_utils.hpp"
+#include "../core/profiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+namespace quantlab::data {
+
+BarCache::BarCache(std::string directory)
+    : directory_(std::move(directory)), enabled_(true) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        // A broken cache must never break a backtest - fall back to network only
+        std::cerr << "⚠️  Bar cache disabled, cannot create " << directory_ << ": " << ec.message() << std::endl;
+        enabled_ = false;
+    }
+}
+
+std::string BarCache::path_for(const std::string& symbol, const std::string& timeframe) const {
+    return (std::filesystem::path(directory_) / (symbol + "_" + timeframe + ".bars")).string();
+}
+
+BarCache::Entry& BarCache::entry(const std::string& symbol, const std::string& timeframe) {
+    std::string key = symbol + "_" + timeframe;
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    // First touch of this key - load whatever a previous run left on disk
+    Entry& fresh = entries_[key];
+    if (enabled_) {
+        read_file(path_for(symbol, timeframe), fresh);
+    }
+    return fresh;
+}
+
+uint64_t BarCache::scan_file(std::ifstream& file, uint64_t file_size,
+                             const std::function<bool(const ChunkHeader&)>& read_chunk) {
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return 0;
+    }
+
+    uint64_t valid = sizeof(header);
+    ChunkHeader chunk{};
+    while (file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk))) {
+        // Never trust bar_count beyond what the file can hold (torn tail or corrupt header)
+        uint64_t body = static_cast<uint64_t>(chunk.bar_count) * sizeof(BarRecord);
+        if (body > file_size - valid - sizeof(chunk) || !read_chunk(chunk)) break;
+        valid += sizeof(chunk) + body;
+    }
+    return valid;
+}
+
+void BarCache::read_file(const std::string& path, Entry& entry) {
+    QUANTLAB_PROFILE_SCOPE(CACHE);
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::file_size(path, ec);
+    std::ifstream file(path, std::ios::binary);
+    if (ec || !file.is_open()) {
+        return;  // Nothing cached yet
+    }
+
+    std::vector<BarRecord> records;
+    uint64_t valid = scan_file(file, file_size, [&](const ChunkHeader& chunk) {
+        size_t offset = records.size();
+        records.resize(offset + chunk.bar_count);
+        if (!file.read(reinterpret_cast<char*>(records.data() + offset), chunk.bar_count * sizeof(BarRecord))) {
+            records.resize(offset);
+            return false;
+        }
+        add_coverage(entry, {chunk.first_day, chunk.last_day});
+        return true;
+    });
+    if (valid == 0) {
+        std::cerr << "⚠️  Ignoring incompatible bar cache file " << path << std::endl;
+        return;
+    }
+
+    merge_records(entry, records);
+}
+
+std::vector<DayRange> BarCache::missing_ranges(const std::string& symbol, const std::string& timeframe,
+                                               int32_t first_day, int32_t last_day) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<DayRange> missing;
+    const Entry& e = entry(symbol, timeframe);
+
+    int32_t cursor = first_day;
+    for (const auto& range : e.covered) {
+        if (range.last_day < cursor) continue;
+        if (range.first_day > last_day) break;
+        if (range.first_day > cursor) {
+            missing.push_back({cursor, range.first_day - 1});
+        }
+        cursor = range.last_day + 1;
+        if (cursor > last_day) break;
+    }
+    if (cursor <= last_day) {
+        missing.push_back({cursor, last_day});
+    }
+    return missing;
+}
+
+std::vector<quantlab::core::Bar> BarCache::load(const std::string& symbol, const std::string& timeframe,
+                                                int32_t first_day, int32_t last_day) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QUANTLAB_PROFILE_SCOPE(CACHE);
+    const Entry& e = entry(symbol, timeframe);
+
+    const int64_t begin_ns = static_cast<int64_t>(first_day) * quantlab::core::NANOS_PER_DAY;
+    const int64_t end_ns = static_cast<int64_t>(last_day + 1) * quantlab::core::NANOS_PER_DAY;
+
+    auto lo = std::lower_bound(e.records.begin(), e.records.end(), begin_ns,
+                               [](const BarRecord& r, int64_t ts) { return r.timestamp_ns < ts; });
+    auto hi = std::lower_bound(lo, e.records.end(), end_ns,
+                               [](const BarRecord& r, int64_t ts) { return r.timestamp_ns < ts; });
+
+    std::vector<quantlab::core::Bar> bars;
+    bars.reserve(std::distance(lo, hi));
+    for (auto it = lo; it != hi; ++it) {
+        quantlab::core::Bar bar(it->timestamp_ns, it->open, it->high, it->low, it->close, it->volume);
+        bar.timestamp = quantlab::core::format_iso8601(it->timestamp_ns);
+        bars.push_back(std::move(bar));
+    }
+    return bars;
+}
+
+void BarCache::append(const std::string& symbol, const std::string& timeframe,
+                      int32_t first_day, int32_t last_day,
+                      const quantlab::core::BarColumnsView& bars) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QUANTLAB_PROFILE_SCOPE(CACHE);
+    Entry& e = entry(symbol, timeframe);
+
+    std::vector<BarRecord> records;
+    records.reserve(bars.size());
+    for (size_t i = 0; i < bars.size(); ++i) {
+        records.push_back({bars.timestamp_ns[i], bars.open[i], bars.high[i], bars.low[i], bars.close[i], bars.volume[i]});
+    }
+
+    if (enabled_) {
+        std::string path = path_for(symbol, timeframe);
+
+        // Cut off a torn tail (or restart an incompatible file) first: anything appended after
+        // garbage would be unreadable. Re-scanned here as another process may have appended since.
+        bool new_file = true;
+        std::error_code ec;
+        uint64_t file_size = std::filesystem::file_size(path, ec);
+        if (!ec) {
+            uint64_t valid = 0;
+            {
+                std::ifstream existing(path, std::ios::binary);
+                valid = scan_file(existing, file_size, [&](const ChunkHeader& chunk) {
+                    return static_cast<bool>(existing.seekg(chunk.bar_count * sizeof(BarRecord), std::ios::cur));
+                });
+            }
+            if (valid < file_size) std::filesystem::resize_file(path, valid, ec);
+            new_file = valid == 0;
+        } else {
+            ec.clear();  // No file yet
+        }
+
+        std::ofstream file;
+        if (!ec) file.open(path, std::ios::binary | std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "⚠️  Could not write bar cache " << path << std::endl;
+        } else {
+            if (new_file) {
+                FileHeader header{};
+                std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+                header.version = VERSION;
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            }
+            ChunkHeader chunk{first_day, last_day, static_cast<uint32_t>(records.size()), 0};
+            file.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+            file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(BarRecord));
+        }
+    }
+
+    add_coverage(e, {first_day, last_day});
+    merge_records(e, records);
+}
+
+void BarCache::add_coverage(Entry& entry, DayRange range) {
+    auto& covered = entry.covered;
+    auto pos = std::lower_bound(covered.begin(), covered.end(), range,
+                                [](const DayRange& a, const DayRange& b) { return a.first_day < b.first_day; });
+    covered.insert(pos, range);
+
+    // Merge overlapping or adjacent ranges
+    std::vector<DayRange> merged;
+    merged.reserve(covered.size());
+    for (const auto& r : covered) {
+        if (!merged.empty() && r.first_day <= merged.back().last_day + 1) {
+            merged.back().last_day = std::max(merged.back().last_day, r.last_day);
+        } else {
+            merged.push_back(r);
+        }
+    }
+    covered = std::move(merged);
+}
+
+void BarCache::merge_records(Entry& entry, const std::vector<BarRecord>& fresh) {
+    if (fresh.empty()) return;
+
+    auto& records = entry.records;
+    size_t middle = records.size();
+    records.insert(records.end(), fresh.begin(), fresh.end());
+
+    auto by_time = [](const BarRecord& a, const BarRecord& b) { return a.timestamp_ns < b.timestamp_ns; };
+    std::stable_sort(records.begin() + middle, records.end(), by_time);
+    std::inplace_merge(records.begin(), records.begin() + middle, records.end(), by_time);
+
+    // Overlapping fetches can return the same bar twice - keep one copy per timestamp
+    records.erase(std::unique(records.begin(), records.end(),
+                              [](const BarRecord& a, const BarRecord& b) { return a.timestamp_ns == b.timestamp_ns; }),
+                  records.end());
+}
+
+} // namespace quantlab::data
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include "../core/data_types.hpp"
+
+namespace quantlab::data {
+
+/**
+ * Inclusive range of UTC epoch days
+ */
+struct DayRange {
+    int32_t first_day;
+    int32_t last_day;
+};
+
+/**
+ * Persistent on-disk bar store keyed by symbol + timeframe
+ *
+ * One append-only binary file per key (<directory>/<SYMBOL>_<timeframe>.bars).
+ * Every successful fetch is appended as a chunk that records the day range
+ * it covered, so days without bars (weekends, holidays) are remembered too
+ * and never re-requested.
+ *
+ * FILE LAYOUT (little-endian, native alignment):
+ *   FileHeader  { char magic[8] = "QLBARS\0\0"; uint32_t version; uint32_t reserved; }
+ *   repeated:
+ *     ChunkHeader { int32_t first_day; int32_t last_day; uint32_t bar_count; uint32_t reserved; }
+ *     BarRecord[bar_count]
+ *
+ * A chunk cut short by a crash mid-write (or with a bar_count larger than
+ * the rest of the file) is ignored on the next load and cut off before the
+ * next append, so chunks written after it stay readable.
+ * All public methods are thread-safe (concurrent loaders share one cache).
+ */
+class BarCache {
+public:
+    // Fixed-size POD mirror of core::Bar (the ISO string is rebuilt from timestamp_ns)
+    struct BarRecord {
+        int64_t timestamp_ns;
+        double open;
+        double high;
+        double low;
+        double close;
+        int64_t volume;
+    };
+
+    explicit BarCache(std::string directory);
+
+    // Day ranges inside [first_day, last_day] that have never been fetched
+    std::vector<DayRange> missing_ranges(const std::string& symbol, const std::string& timeframe,
+                                         int32_t first_day, int32_t last_day);
+
+    // Cached bars whose timestamp falls inside [first_day, last_day], oldest first
+    std::vector<quantlab::core::Bar> load(const std::string& symbol, const std::string& timeframe,
+                                          int32_t first_day, int32_t last_day);
+
+    // Record a completed fetch of [first_day, last_day] (bars may be empty)
+    void append(const std::string& symbol, const std::string& timeframe,
+                int32_t first_day, int32_t last_day,
+                const quantlab::core::BarColumnsView& bars);
+
+    const std::string& directory() const { return directory_; }
+
+private:
+    static constexpr char MAGIC[8] = {'Q', 'L', 'B', 'A', 'R', 'S', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct ChunkHeader {
+        int32_t first_day;
+        int32_t last_day;
+        uint32_t bar_count;
+        uint32_t reserved;
+    };
+
+    struct Entry {
+        std::vector<DayRange> covered;     // Sorted, non-overlapping, merged
+        std::vector<BarRecord> records;    // Sorted by timestamp_ns, unique
+    };
+
+    std::string directory_;
+    bool enabled_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::mutex mutex_;
+
+    std::string path_for(const std::string& symbol, const std::string& timeframe) const;
+    Entry& entry(const std::string& symbol, const std::string& timeframe);
+    void read_file(const std::string& path, Entry& entry);
+
+    // Walk the chunks of an open cache file of file_size bytes. read_chunk is called with the stream at
+    // each complete chunk's records and must consume them. Returns the length of the valid prefix:
+    // 0 for an incompatible file, else the end of the last complete chunk.
+    static uint64_t scan_file(std::ifstream& file, uint64_t file_size,
+                              const std::function<bool(const ChunkHeader&)>& read_chunk);
+
+    static void add_coverage(Entry& entry, DayRange range);
+    static void merge_records(Entry& entry, const std::vector<BarRecord>& fresh);
+};
+
+} // namespace quantlab::data
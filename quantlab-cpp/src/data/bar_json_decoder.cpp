@@ -0,0 +1,234 @@
+#include "bar_json_decoder.hpp"
+#include "../core/time_utils.hpp"
+#include "../core/profiler.hpp"
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace quantlab::data {
+
+namespace {
+
+using json = nlohmann::json;
+
+// Per-row policy for decode_bar_page: single-letter keys, OHLCV into the columns
+class BarRows {
+public:
+    static constexpr std::string_view ARRAY_KEY = "bars";
+
+    explicit BarRows(quantlab::core::BarColumns& out) : out_(out) {}
+
+    void begin() {
+        seen_ = 0;
+        volume_ = 0;
+    }
+
+    void key(std::string_view key) {
+        field_ = key.size() != 1 ? NONE :
+                 key[0] == 't' ? T : key[0] == 'o' ? O : key[0] == 'h' ? H :
+                 key[0] == 'l' ? L : key[0] == 'c' ? C : key[0] == 'v' ? V : NONE;
+    }
+
+    // Prices may arrive as integers ("o":150) and volume as a float - accept either
+    void number(double value, int64_t integer) {
+        switch (field_) {
+            case O: open_ = value; break;
+            case H: high_ = value; break;
+            case L: low_ = value; break;
+            case C: close_ = value; break;
+            case V: volume_ = integer; break;
+            default: return;
+        }
+        seen_ |= 1u << field_;
+    }
+
+    void string(std::string_view value) {
+        if (field_ != T) return;
+        timestamp_ns_ = quantlab::core::parse_iso8601_to_nanoseconds(value);
+        seen_ |= 1u << T;
+    }
+
+    bool end() {
+        if ((seen_ & REQUIRED) != REQUIRED) return false;
+        out_.push_back(timestamp_ns_, open_, high_, low_, close_, volume_);
+        return true;
+    }
+
+private:
+    enum Field : unsigned { NONE, T, O, H, L, C, V };
+    static constexpr unsigned REQUIRED = 1u << T | 1u << O | 1u << H | 1u << L | 1u << C;
+
+    quantlab::core::BarColumns& out_;
+    Field field_ = NONE;
+    unsigned seen_ = 0;
+    int64_t timestamp_ns_ = 0;
+    double open_ = 0.0, high_ = 0.0, low_ = 0.0, close_ = 0.0;
+    int64_t volume_ = 0;
+};
+
+// Per-row policy for decode_trade_page: t/p/s into a Tick
+class TradeRows {
+public:
+    static constexpr std::string_view ARRAY_KEY = "trades";
+
+    explicit TradeRows(std::vector<quantlab::core::Tick>& out) : out_(out) {}
+
+    void begin() { seen_ = 0; }
+
+    void key(std::string_view key) {
+        field_ = key.size() != 1 ? NONE : key[0] == 't' ? T : key[0] == 'p' ? P : key[0] == 's' ? S : NONE;
+    }
+
+    void number(double value, int64_t integer) {
+        if (field_ == P) {
+            tick_.price = value;
+        } else if (field_ == S) {
+            tick_.quantity = static_cast<int32_t>(integer);
+        } else {
+            return;
+        }
+        seen_ |= 1u << field_;
+    }
+
+    void string(std::string_view value) {
+        if (field_ != T) return;
+        tick_.timestamp_ns = quantlab::core::parse_iso8601_to_nanoseconds(value);
+        seen_ |= 1u << T;
+    }
+
+    bool end() {
+        if ((seen_ & REQUIRED) != REQUIRED) return false;
+        out_.push_back(tick_);
+        return true;
+    }
+
+private:
+    enum Field : unsigned { NONE, T, P, S };
+    static constexpr unsigned REQUIRED = 1u << T | 1u << P | 1u << S;
+
+    std::vector<quantlab::core::Tick>& out_;
+    Field field_ = NONE;
+    unsigned seen_ = 0;
+    quantlab::core::Tick tick_{0, 0.0, 0, 'T'};
+};
+
+// SAX handler shared by both page shapes: finds the rows array and next_page_token,
+// and hands everything inside one row object to the Rows policy
+template<typename Rows>
+class PageHandler {
+public:
+    PageHandler(Rows rows, PageDecodeResult& result) : rows_(rows), result_(result) {}
+
+    bool null() { return true; }
+    bool boolean(bool) { return true; }
+    bool number_integer(json::number_integer_t value) { return number(static_cast<double>(value), value); }
+    bool number_unsigned(json::number_unsigned_t value) {
+        return number(static_cast<double>(value), static_cast<int64_t>(value));
+    }
+    bool number_float(json::number_float_t value, const json::string_t&) {
+        return number(value, static_cast<int64_t>(value));
+    }
+    bool binary(json::binary_t&) { return true; }
+
+    bool string(json::string_t& value) {
+        if (in_row()) {
+            rows_.string(value);
+        } else if (depth_ == 1 && top_key_ == TopKey::NEXT_PAGE_TOKEN) {
+            result_.next_page_token = value;
+        }
+        return true;
+    }
+
+    bool key(json::string_t& key) {
+        if (depth_ == 1) {
+            top_key_ = key == Rows::ARRAY_KEY ? TopKey::ROWS :
+                       key == "next_page_token" ? TopKey::NEXT_PAGE_TOKEN : TopKey::OTHER;
+        } else if (in_row()) {
+            rows_.key(key);
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        ++depth_;
+        if (in_row()) rows_.begin();
+        return true;
+    }
+
+    bool end_object() {
+        if (in_row()) {
+            if (rows_.end()) {
+                ++result_.rows;
+            } else {
+                ++result_.skipped;
+            }
+        }
+        --depth_;
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        ++depth_;
+        if (depth_ == 2 && top_key_ == TopKey::ROWS) in_rows_ = true;
+        return true;
+    }
+
+    bool end_array() {
+        if (depth_ == 2) in_rows_ = false;
+        --depth_;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
+        std::cerr << "❌ JSON parsing error: " << e.what() << std::endl;
+        return false;
+    }
+
+private:
+    enum class TopKey { OTHER, ROWS, NEXT_PAGE_TOKEN };
+
+    Rows rows_;
+    PageDecodeResult& result_;
+
+    int depth_ = 0;                    // 1 = top-level object, 2 = rows array, 3 = one row
+    TopKey top_key_ = TopKey::OTHER;
+    bool in_rows_ = false;
+
+    bool in_row() const { return in_rows_ && depth_ == 3; }
+
+    bool number(double value, int64_t integer) {
+        if (in_row()) rows_.number(value, integer);
+        return true;
+    }
+};
+
+template<typename Rows>
+PageDecodeResult decode_page(std::string_view json, Rows rows) {
+    PageDecodeResult result;
+    PageHandler<Rows> handler(rows, result);
+    result.ok = json::sax_parse(json.begin(), json.end(), &handler);
+    return result;
+}
+
+// Rough size of one encoded row, used to size the output before decoding
+constexpr size_t BYTES_PER_BAR_ESTIMATE = 96;
+constexpr size_t BYTES_PER_TRADE_ESTIMATE = 112;
+
+} // namespace
+
+PageDecodeResult decode_bar_page(std::string_view json, quantlab::core::BarColumns& out) {
+    QUANTLAB_PROFILE_SCOPE(PARSE);
+    if (out.empty()) out.reserve(json.size() / BYTES_PER_BAR_ESTIMATE);  // Later pages grow geometrically
+    auto result = decode_page(json, BarRows(out));
+    QUANTLAB_PROFILE_COUNT(BARS_DECODED, result.rows);
+    return result;
+}
+
+PageDecodeResult decode_trade_page(std::string_view json, std::vector<quantlab::core::Tick>& out) {
+    QUANTLAB_PROFILE_SCOPE(PARSE);
+    if (out.empty()) out.reserve(json.size() / BYTES_PER_TRADE_ESTIMATE);
+    auto result = decode_page(json, TradeRows(out));
+    QUANTLAB_PROFILE_COUNT(TICKS_DECODED, result.rows);
+    return result;
+}
+
+} // namespace quantlab::data
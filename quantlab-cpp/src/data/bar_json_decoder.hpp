@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include "../core/data_types.hpp"
+
+namespace quantlab::data {
+
+/**
+ * Outcome of decoding one page of the bars or trades endpoint
+ */
+struct PageDecodeResult {
+    bool ok = false;               // False: malformed JSON (rows decoded before the error stay appended)
+    size_t rows = 0;               // Bars / ticks appended to the output
+    size_t skipped = 0;            // Objects missing a required field
+    std::string next_page_token;   // Empty on the last page
+};
+
+/**
+ * Streaming decoder for /v2/stocks/{symbol}/bars responses
+ *
+ *   {"bars":[{"t":"2024-01-02T05:00:00Z","o":..,"h":..,"l":..,"c":..,"v":..,"n":..,"vw":..},...],
+ *    "symbol":"AAPL","next_page_token":null}
+ *
+ * Runs nlohmann's SAX parser instead of building a DOM: every bar goes
+ * straight into the columns, and "t" is parsed into timestamp_ns while it
+ * is still the lexer's token - no per-bar node or string allocation. The
+ * ISO strings are not kept (format_iso8601 rebuilds them when needed).
+ * Bars need t/o/h/l/c; a missing "v" counts as zero volume.
+ */
+PageDecodeResult decode_bar_page(std::string_view json, quantlab::core::BarColumns& out);
+
+/**
+ * Same for /v2/stocks/{symbol}/trades responses, appending one Tick per trade
+ *
+ *   {"trades":[{"t":"2024-01-02T14:30:00.123456789Z","x":"V","p":..,"s":..,"c":["@"],"i":..,"z":"C"},...],
+ *    "symbol":"AAPL","next_page_token":"..."}
+ *
+ * Trades need t/p/s; exchange, conditions and tape are skipped.
+ */
+PageDecodeResult decode_trade_page(std::string_view json, std::vector<quantlab::core::Tick>& out);
+
+} // namespace quantlab::data
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <memory>
+#include "../core/data_types.hpp"
+
+namespace quantlab::data {
+
+class BarCache;
+
+/**
+ * Where strategies and the optimizer get their market data
+ *
+ * AlpacaClient implements it against the REST API; SyntheticDataSource
+ * (data/synthetic_data.hpp) generates seeded series offline. Calls must be
+ * safe to make from several threads at once (the optimizer loads symbols
+ * concurrently).
+ */
+class DataSource {
+public:
+    virtual ~DataSource() = default;
+
+    // Reachability check before a run (prints what it checked)
+    virtual bool test_connection() = 0;
+
+    // Bars in [start_date, end_date] ("YYYY-MM-DD"; empty = the source's default window)
+    virtual quantlab::core::BarColumns get_historical_bar_columns(
+        const std::string& symbol,
+        const std::string& timeframe = "1Day",
+        const std::string& start_date = "",
+        const std::string& end_date = ""
+    ) = 0;
+
+    // The total_days calendar days ending HISTORY_LAG_DAYS before today, as Bar rows with ISO timestamps
+    virtual std::vector<quantlab::core::Bar> get_aggregated_historical_bars(
+        const std::string& symbol,
+        const std::string& timeframe = "1Day",
+        int total_days = 250,
+        int days_per_call = 1
+    ) = 0;
+
+    virtual std::optional<quantlab::core::Quote> get_latest_quote(const std::string& symbol) = 0;
+
+    // Persistent bar store behind the historical requests (null = none; internally synchronized)
+    virtual BarCache* bar_cache() const { return nullptr; }
+};
+
+// QUANTLAB_DATA_SOURCE=synthetic -> SyntheticDataSource (seed QUANTLAB_SYNTHETIC_SEED, default 42),
+// anything else -> AlpacaClient (throws if its credentials are missing)
+std::shared_ptr<DataSource> make_data_source_from_env();
+
+} // namespace quantlab::data
@@ -0,0 +1,165 @@
+#include "mapped_bar_file.hpp"
+#include "../core/profiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <cerrno>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace quantlab::data {
+
+namespace {
+
+std::string padded_field(const char* field, size_t size) {
+    return std::string(field, strnlen(field, size));
+}
+
+template<typename T>
+void write_column(std::ofstream& file, std::span<const T> column) {
+    file.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size_bytes()));
+}
+
+} // namespace
+
+MappedBarFile::MappedBarFile(const void* base, size_t length) : base_(base), length_(length) {
+    const size_t n = static_cast<size_t>(header().bar_count);
+    const auto* bytes = static_cast<const char*>(base_) + sizeof(Header);
+    auto column = [&](size_t index) { return bytes + index * n * sizeof(int64_t); };
+    view_ = {
+        std::span<const int64_t>(reinterpret_cast<const int64_t*>(column(0)), n),
+        std::span<const double>(reinterpret_cast<const double*>(column(1)), n),
+        std::span<const double>(reinterpret_cast<const double*>(column(2)), n),
+        std::span<const double>(reinterpret_cast<const double*>(column(3)), n),
+        std::span<const double>(reinterpret_cast<const double*>(column(4)), n),
+        std::span<const int64_t>(reinterpret_cast<const int64_t*>(column(5)), n),
+    };
+}
+
+MappedBarFile::MappedBarFile(MappedBarFile&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)), length_(std::exchange(other.length_, 0)),
+      view_(std::exchange(other.view_, {})) {}
+
+MappedBarFile& MappedBarFile::operator=(MappedBarFile&& other) noexcept {
+    if (this != &other) {
+        if (base_) munmap(const_cast<void*>(base_), length_);
+        base_ = std::exchange(other.base_, nullptr);
+        length_ = std::exchange(other.length_, 0);
+        view_ = std::exchange(other.view_, {});
+    }
+    return *this;
+}
+
+MappedBarFile::~MappedBarFile() {
+    if (base_) munmap(const_cast<void*>(base_), length_);
+}
+
+std::optional<MappedBarFile> MappedBarFile::open(const std::string& path) {
+    QUANTLAB_PROFILE_SCOPE(CACHE);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;  // Not written yet
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        std::cerr << "⚠️  Ignoring truncated bar file " << path << std::endl;
+        return std::nullopt;
+    }
+    const size_t length = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        std::cerr << "⚠️  Could not map bar file " << path << ": " << std::strerror(errno) << std::endl;
+        return std::nullopt;
+    }
+
+    const auto* header = static_cast<const Header*>(base);
+    const uint64_t max_bars = (length - sizeof(Header)) / (6 * sizeof(int64_t));
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+        header->bar_count > max_bars) {
+        munmap(base, length);
+        std::cerr << "⚠️  Ignoring incompatible bar file " << path << std::endl;
+        return std::nullopt;
+    }
+
+    // Backtests walk the columns front to back
+    madvise(base, length, MADV_SEQUENTIAL);
+    return MappedBarFile(base, length);
+}
+
+bool MappedBarFile::write(const std::string& path, const std::string& symbol, const std::string& timeframe,
+                          int32_t first_day, int32_t last_day, const quantlab::core::BarColumnsView& bars) {
+    QUANTLAB_PROFILE_SCOPE(CACHE);
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.bar_count = bars.size();
+    std::strncpy(header.symbol, symbol.c_str(), sizeof(header.symbol) - 1);
+    std::strncpy(header.timeframe, timeframe.c_str(), sizeof(header.timeframe) - 1);
+    header.first_day = first_day;
+    header.last_day = last_day;
+
+    // mkstemp reserves a fresh temp file per call, so concurrent writers of the same key - other
+    // processes or other optimizer threads in this one - never share one; the last rename wins
+    std::string temp_path = path + ".tmp.XXXXXX";
+    int fd = mkstemp(temp_path.data());
+    if (fd < 0) {
+        std::cerr << "⚠️  Could not create bar file " << temp_path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    fchmod(fd, 0644);  // mkstemp creates 0600; the published file is read by other processes
+    close(fd);
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "⚠️  Could not write bar file " << temp_path << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_column(file, bars.timestamp_ns);
+        write_column(file, bars.open);
+        write_column(file, bars.high);
+        write_column(file, bars.low);
+        write_column(file, bars.close);
+        write_column(file, bars.volume);
+        if (!file) {
+            std::cerr << "⚠️  Could not write bar file " << temp_path << std::endl;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::cerr << "⚠️  Could not replace bar file " << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string MappedBarFile::path_for(const std::string& directory, const std::string& symbol,
+                                    const std::string& timeframe) {
+    return (std::filesystem::path(directory) / (symbol + "_" + timeframe + ".qlcol")).string();
+}
+
+std::string MappedBarFile::symbol() const {
+    return padded_field(header().symbol, sizeof(Header::symbol));
+}
+
+std::string MappedBarFile::timeframe() const {
+    return padded_field(header().timeframe, sizeof(Header::timeframe));
+}
+
+} // namespace quantlab::data
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include "../core/data_types.hpp"
+
+namespace quantlab::data {
+
+/**
+ * Read-only memory-mapped columnar bar file
+ *
+ * The bar cache is an append log of chunks; this is its compacted, fixed
+ * layout counterpart for backtest input. The numeric columns are stored
+ * exactly as BarColumnsView expects them, so view() points straight into the
+ * mapping: no parse, no copy, no per-bar allocation. Every process mapping
+ * the same file shares one copy in the page cache, which is what lets many
+ * optimizer workers on a host run off a single history.
+ *
+ * FILE LAYOUT (<directory>/<SYMBOL>_<timeframe>.qlcol, little-endian):
+ *   Header (64 bytes)
+ *     char magic[8] = "QLCOLS\0\0" | u32 version | u32 reserved | u64 bar_count
+ *     char symbol[16] | char timeframe[16]         NUL padded
+ *     i32 first_day | i32 last_day                 UTC epoch days the history was requested for
+ *   int64_t timestamp_ns[bar_count]
+ *   double  open[bar_count] | high[...] | low[...] | close[...]
+ *   int64_t volume[bar_count]
+ *
+ * Files are written to a temp name and renamed into place, so a process that
+ * already has the old file mapped keeps a consistent snapshot.
+ */
+class MappedBarFile {
+public:
+    static constexpr char MAGIC[8] = {'Q', 'L', 'C', 'O', 'L', 'S', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t bar_count;
+        char symbol[16];
+        char timeframe[16];
+        int32_t first_day;
+        int32_t last_day;
+    };
+    static_assert(sizeof(Header) == 64, "column data must start 8-byte aligned");
+
+    MappedBarFile(const MappedBarFile&) = delete;
+    MappedBarFile& operator=(const MappedBarFile&) = delete;
+    MappedBarFile(MappedBarFile&& other) noexcept;
+    MappedBarFile& operator=(MappedBarFile&& other) noexcept;
+    ~MappedBarFile();
+
+    // Map an existing file; nullopt if it is missing, truncated or from another version
+    static std::optional<MappedBarFile> open(const std::string& path);
+
+    // Write bars in the layout above (atomically replaces an existing file)
+    static bool write(const std::string& path, const std::string& symbol, const std::string& timeframe,
+                      int32_t first_day, int32_t last_day, const quantlab::core::BarColumnsView& bars);
+
+    static std::string path_for(const std::string& directory, const std::string& symbol,
+                                const std::string& timeframe);
+
+    // Columns inside the mapping - valid while this object lives
+    const quantlab::core::BarColumnsView& view() const { return view_; }
+    size_t size() const { return view_.size(); }
+
+    const Header& header() const { return *static_cast<const Header*>(base_); }
+    std::string symbol() const;
+    std::string timeframe() const;
+
+    // True if the file was requested for at least [first_day, last_day]
+    bool covers(int32_t first_day, int32_t last_day) const {
+        return header().first_day <= first_day && header().last_day >= last_day;
+    }
+
+private:
+    MappedBarFile(const void* base, size_t length);
+
+    const void* base_ = nullptr;
+    size_t length_ = 0;
+    quantlab::core::BarColumnsView view_;
+};
+
+} // namespace quantlab::data
@@ -0,0 +1,270 @@
+#include "market_stream.hpp"
+#include "../core/time_utils.hpp"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <poll.h>
+#include <curl/curl.h>
+#include <nlohmann/json.hpp>
+
+namespace quantlab::data {
+
+namespace {
+
+constexpr int POLL_MS = 200;                 // How often the I/O loop looks at stopping_
+constexpr int INITIAL_BACKOFF_MS = 500;
+constexpr int MAX_BACKOFF_MS = 30'000;
+
+int64_t wall_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Wait until the connection's socket is ready (or POLL_MS passes)
+void wait_for_socket(curl_socket_t socket, short events) {
+    pollfd ready{static_cast<int>(socket), events, 0};
+    ::poll(&ready, 1, POLL_MS);
+}
+
+// "wss://host/path" -> "wss"
+std::string url_scheme(const std::string& url) {
+    auto end = url.find("://");
+    std::string scheme = end == std::string::npos ? "" : url.substr(0, end);
+    std::transform(scheme.begin(), scheme.end(), scheme.begin(), ::tolower);
+    return scheme;
+}
+
+bool curl_supports(const std::string& scheme) {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    for (const char* const* protocol = info->protocols; protocol && *protocol; ++protocol) {
+        if (scheme == *protocol) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+MarketDataStream::MarketDataStream() {
+    const char* key_id = std::getenv("ALPACA_API_KEY_ID");
+    if (!key_id) {
+        throw std::runtime_error("Missing ALPACA_API_KEY_ID environment variable");
+    }
+    api_key_ = key_id;
+
+    const char* secret = std::getenv("ALPACA_API_SECRET_KEY");
+    if (!secret) {
+        throw std::runtime_error("Missing ALPACA_API_SECRET_KEY environment variable");
+    }
+    api_secret_ = secret;
+
+    const char* stream_url = std::getenv("ALPACA_STREAM_URL");
+    url_ = stream_url && *stream_url ? stream_url : DEFAULT_URL;
+}
+
+MarketDataStream::~MarketDataStream() {
+    stop();
+}
+
+std::shared_ptr<MarketUpdateQueue> MarketDataStream::subscribe(const std::string& symbol, size_t queue_capacity) {
+    if (running_) {
+        std::cerr << "❌ Error: Subscribe to " << symbol << " before starting the market stream" << std::endl;
+        return nullptr;
+    }
+    quantlab::core::SymbolId id = symbols_.intern(symbol);
+    if (id == queues_.size()) {
+        queues_.push_back(std::make_shared<MarketUpdateQueue>(queue_capacity));
+    }
+    return queues_[id];
+}
+
+bool MarketDataStream::start() {
+    if (running_ || io_thread_.joinable()) {
+        return false;
+    }
+    if (queues_.empty()) {
+        std::cerr << "❌ Error: Market stream has no subscriptions" << std::endl;
+        return false;
+    }
+    std::string scheme = url_scheme(url_);
+    if (!curl_supports(scheme)) {
+        std::cerr << "❌ Error: libcurl " << curl_version_info(CURLVERSION_NOW)->version
+                  << " was built without '" << scheme << "' (WebSocket) support" << std::endl;
+        return false;
+    }
+
+    stopping_ = false;
+    running_ = true;
+    io_thread_ = std::thread(&MarketDataStream::run, this);
+    return true;
+}
+
+void MarketDataStream::stop() {
+    stopping_ = true;
+    if (io_thread_.joinable()) {
+        io_thread_.join();
+    }
+    running_ = false;
+}
+
+void MarketDataStream::run() {
+    int backoff_ms = INITIAL_BACKOFF_MS;
+    while (!stopping_) {
+        // A session that got as far as streaming is retried quickly; repeated failures back off
+        if (run_session()) backoff_ms = INITIAL_BACKOFF_MS;
+        connected_ = false;
+        if (stopping_) break;
+
+        ++reconnects_;
+        std::cerr << "⚠️  Market stream disconnected, reconnecting in " << backoff_ms << " ms" << std::endl;
+        for (int waited = 0; waited < backoff_ms && !stopping_; waited += POLL_MS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS));
+        }
+        backoff_ms = std::min(backoff_ms * 2, MAX_BACKOFF_MS);
+    }
+    running_ = false;
+}
+
+bool MarketDataStream::run_session() {
+    std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> handle(curl_easy_init(), curl_easy_cleanup);
+    CURL* curl = handle.get();
+    if (!curl) {
+        return false;
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, url_.c_str());
+    curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 2L);  // Stop after the WebSocket upgrade; frames go through curl_ws_*
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
+
+    CURLcode rc = curl_easy_perform(curl);
+    if (rc != CURLE_OK) {
+        std::cerr << "❌ Market stream connect to " << url_ << " failed: " << curl_easy_strerror(rc) << std::endl;
+        return false;
+    }
+    curl_socket_t socket = CURL_SOCKET_BAD;
+    curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &socket);
+
+    auto send_text = [&](const std::string& text) {
+        size_t offset = 0;
+        while (offset < text.size() && !stopping_) {
+            size_t sent = 0;
+            CURLcode send_rc = curl_ws_send(curl, text.data() + offset, text.size() - offset, &sent, 0, CURLWS_TEXT);
+            if (send_rc == CURLE_AGAIN) {
+                wait_for_socket(socket, POLLOUT);
+                continue;
+            }
+            if (send_rc != CURLE_OK) {
+                std::cerr << "❌ Market stream send failed: " << curl_easy_strerror(send_rc) << std::endl;
+                return false;
+            }
+            offset += sent;
+        }
+        return true;
+    };
+
+    std::string frame;  // Reassembles fragmented messages
+    char buffer[64 * 1024];
+    while (!stopping_) {
+        size_t received = 0;
+        const curl_ws_frame* meta = nullptr;
+        rc = curl_ws_recv(curl, buffer, sizeof(buffer), &received, &meta);
+        if (rc == CURLE_AGAIN) {
+            wait_for_socket(socket, POLLIN);
+            continue;
+        }
+        if (rc != CURLE_OK) {
+            std::cerr << "⚠️  Market stream receive failed: " << curl_easy_strerror(rc) << std::endl;
+            break;
+        }
+        if (meta->flags & CURLWS_CLOSE) {
+            std::cerr << "⚠️  Market stream closed by server" << std::endl;
+            break;
+        }
+        if (!(meta->flags & (CURLWS_TEXT | CURLWS_BINARY))) {
+            continue;  // Ping / pong - libcurl answers pings itself
+        }
+
+        frame.append(buffer, received);
+        if (meta->bytesleft > 0 || (meta->flags & CURLWS_CONT)) {
+            continue;  // Rest of the message still on the wire
+        }
+        bool sent = true;
+        for (const auto& reply : handle_frame(frame)) {
+            sent = sent && send_text(reply);
+        }
+        frame.clear();
+        if (!sent) break;
+    }
+    return connected_;
+}
+
+std::vector<std::string> MarketDataStream::handle_frame(const std::string& frame) {
+    std::vector<std::string> replies;
+    auto messages = nlohmann::json::parse(frame, nullptr, false);
+    if (messages.is_discarded()) {
+        std::cerr << "⚠️  Market stream: dropping malformed frame: " << frame.substr(0, 200) << std::endl;
+        return replies;
+    }
+    if (!messages.is_array()) {
+        messages = nlohmann::json::array({std::move(messages)});
+    }
+
+    const int64_t received_ns = wall_clock_ns();
+    for (const auto& message : messages) {
+        if (!message.is_object()) continue;
+        // A field of an unexpected type (null, a string for a number) throws: skip that message only,
+        // the I/O thread and the connection keep running
+        try {
+            const std::string type = message.value("T", "");
+
+            if (type == "q" || type == "t") {
+                auto id = symbols_.find(message.value("S", ""));
+                if (!id) continue;  // Not one of ours
+
+                MarketUpdate update;
+                update.symbol = *id;
+                update.received_ns = received_ns;
+                update.timestamp_ns = quantlab::core::parse_iso8601_to_nanoseconds(message.value("t", ""));
+                if (type == "q") {
+                    update.kind = MarketUpdate::Kind::QUOTE;
+                    update.bid_price = message.value("bp", 0.0);
+                    update.ask_price = message.value("ap", 0.0);
+                    update.bid_size = message.value("bs", 0);
+                    update.ask_size = message.value("as", 0);
+                } else {
+                    update.kind = MarketUpdate::Kind::TRADE;
+                    update.price = message.value("p", 0.0);
+                    update.size = message.value("s", 0);
+                }
+                ++received_;
+                if (!queues_[*id]->try_push(update)) {
+                    ++dropped_;  // Consumer is behind; never stall the feed for it
+                }
+            } else if (type == "success") {
+                const std::string msg = message.value("msg", "");
+                if (msg == "connected") {
+                    replies.push_back(nlohmann::json{{"action", "auth"}, {"key", api_key_}, {"secret", api_secret_}}.dump());
+                } else if (msg == "authenticated") {
+                    replies.push_back(subscribe_message());
+                }
+            } else if (type == "subscription") {
+                connected_ = true;
+                std::cout << "📡 Streaming quotes and trades for " << symbols_.size() << " symbols from " << url_ << std::endl;
+            } else if (type == "error") {
+                std::cerr << "❌ Market stream error " << message.value("code", 0) << ": " << message.value("msg", "") << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "⚠️  Market stream: skipping bad message (" << e.what() << "): "
+                      << message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace).substr(0, 200)
+                      << std::endl;
+        }
+    }
+    return replies;
+}
+
+std::string MarketDataStream::subscribe_message() const {
+    return nlohmann::json{{"action", "subscribe"}, {"quotes", symbols_.names()}, {"trades", symbols_.names()}}.dump();
+}
+
+} // namespace quantlab::data
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../core/spsc_queue.hpp"
+#include "../core/symbol_table.hpp"
+
+namespace quantlab::data {
+
+/**
+ * One decoded quote or trade from the streaming feed
+ *
+ * Fixed-size and allocation free so it can sit in an SpscQueue slot; the
+ * symbol is implied by the queue it arrives on.
+ */
+struct MarketUpdate {
+    enum class Kind : uint8_t { QUOTE, TRADE };
+
+    Kind kind = Kind::QUOTE;
+    quantlab::core::SymbolId symbol = 0;
+    int64_t timestamp_ns = 0;   // Exchange timestamp
+    int64_t received_ns = 0;    // Wall clock when the I/O thread decoded it
+    double bid_price = 0.0;     // QUOTE
+    double ask_price = 0.0;
+    int32_t bid_size = 0;
+    int32_t ask_size = 0;
+    double price = 0.0;         // TRADE
+    int32_t size = 0;
+
+    // Same price get_latest_quote() callers trade on
+    double mid_price() const { return (bid_price + ask_price) / 2.0; }
+    // One-sided / empty books show up as zero prices
+    bool two_sided() const { return bid_price > 0.0 && ask_price > 0.0 && ask_price >= bid_price; }
+};
+
+using MarketUpdateQueue = quantlab::core::SpscQueue<MarketUpdate>;
+
+/**
+ * Alpaca market data WebSocket client (quotes and trades)
+ *
+ * A single I/O thread owns the connection: it authenticates, subscribes to
+ * every registered symbol, decodes each frame and pushes the updates into
+ * that symbol's queue. Each queue has exactly one producer (the I/O thread)
+ * and one consumer (whoever drives that symbol's strategy), so hand-off is a
+ * lock-free SpscQueue push - the feed never waits for a slow strategy. When a
+ * queue is full the update is dropped and counted in dropped_updates().
+ *
+ * Lost connections are retried with exponential backoff until stop().
+ *
+ * Usage:   auto aapl = stream.subscribe("AAPL");  ...  stream.start();
+ *          while (auto update = aapl->try_pop()) { ... }
+ *
+ * Reads ALPACA_API_KEY_ID / ALPACA_API_SECRET_KEY like AlpacaClient and the
+ * feed URL from ALPACA_STREAM_URL (default: the free IEX feed).
+ */
+class MarketDataStream {
+public:
+    static constexpr const char* DEFAULT_URL = "wss://stream.data.alpaca.markets/v2/iex";
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    MarketDataStream();
+    ~MarketDataStream();
+
+    MarketDataStream(const MarketDataStream&) = delete;
+    MarketDataStream& operator=(const MarketDataStream&) = delete;
+
+    // Register a symbol before start(); subscribing twice returns the same queue
+    std::shared_ptr<MarketUpdateQueue> subscribe(const std::string& symbol,
+                                                 size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
+
+    // Spawn the I/O thread; false if already running, nothing is subscribed or
+    // this libcurl build has no WebSocket support
+    bool start();
+
+    // Close the connection and join the I/O thread (also done by the destructor)
+    void stop();
+
+    bool running() const { return running_; }
+    bool connected() const { return connected_; }      // Authenticated and subscribed
+    const std::string& url() const { return url_; }
+    const quantlab::core::SymbolTable& symbols() const { return symbols_; }
+
+    size_t received_updates() const { return received_; }
+    size_t dropped_updates() const { return dropped_; }
+    size_t reconnects() const { return reconnects_; }
+
+private:
+    std::string url_;
+    std::string api_key_;
+    std::string api_secret_;
+
+    quantlab::core::SymbolTable symbols_;
+    std::vector<std::shared_ptr<MarketUpdateQueue>> queues_;  // Indexed by SymbolId
+
+    std::thread io_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<size_t> received_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<size_t> reconnects_{0};
+
+    void run();
+
+    // One connection from handshake to close; true if it got as far as streaming
+    bool run_session();
+
+    // Handle one text frame (a JSON array of messages); returns frames to send back
+    std::vector<std::string> handle_frame(const std::string& frame);
+
+    std::string subscribe_message() const;
+};
+
+} // namespace quantlab::data
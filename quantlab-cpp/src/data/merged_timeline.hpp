@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "../core/data_types.hpp"
+#include "../core/symbol_table.hpp"
+
+namespace quantlab::data {
+
+/**
+ * One bar of one symbol on the merged timeline
+ */
+struct TimelineEvent {
+    int64_t timestamp_ns;
+    quantlab::core::SymbolId symbol;
+    size_t index;    // Row in that symbol's stream
+};
+
+/**
+ * K-way merge of per-symbol bar streams into one time-ordered sequence
+ *
+ * streams[id] holds symbol id's bars sorted by timestamp_ns. A binary min-heap
+ * keeps the next unread bar of every stream, so each next() costs O(log k)
+ * for k symbols. Equal timestamps come out in symbol id order, which makes a
+ * run deterministic. Views are borrowed: the caller keeps the bars alive.
+ */
+class MergedTimeline {
+private:
+    std::vector<quantlab::core::BarColumnsView> streams_;
+    std::vector<TimelineEvent> heap_;
+
+    // std heap algorithms build a max-heap; invert to pop the earliest bar first
+    static bool later(const TimelineEvent& a, const TimelineEvent& b) {
+        if (a.timestamp_ns != b.timestamp_ns) return a.timestamp_ns > b.timestamp_ns;
+        return a.symbol > b.symbol;
+    }
+
+public:
+    explicit MergedTimeline(std::vector<quantlab::core::BarColumnsView> streams)
+        : streams_(std::move(streams)) {
+        heap_.reserve(streams_.size());
+        for (size_t id = 0; id < streams_.size(); ++id) {
+            if (!streams_[id].empty()) {
+                heap_.push_back({streams_[id].timestamp_ns[0], static_cast<quantlab::core::SymbolId>(id), 0});
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    bool empty() const { return heap_.empty(); }
+
+    // Timestamp next() will return (call only when !empty())
+    int64_t next_timestamp() const { return heap_.front().timestamp_ns; }
+
+    // Pop the earliest remaining bar; false once every stream is exhausted
+    bool next(TimelineEvent& event) {
+        if (heap_.empty()) return false;
+
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        event = heap_.back();
+
+        // Refill the slot with the same stream's following bar
+        const auto& stream = streams_[event.symbol];
+        size_t following = event.index + 1;
+        if (following < stream.size()) {
+            heap_.back() = {stream.timestamp_ns[following], event.symbol, following};
+            std::push_heap(heap_.begin(), heap_.end(), later);
+        } else {
+            heap_.pop_back();
+        }
+        return true;
+    }
+};
+
+} // namespace quantlab::data
@@ -0,0 +1,54 @@
+#include "multi_symbol_loader.hpp"
+#include "../core/parallel.hpp"
+#include <iostream>
+#include <chrono>
+
+namespace quantlab::data {
+
+std::unordered_map<std::string, std::vector<quantlab::core::Bar>> MultiSymbolLoader::load(
+    const std::vector<std::string>& symbols,
+    const std::string& timeframe,
+    int total_days) {
+    
+    std::vector<LoadRequest> requests;
+    requests.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        requests.push_back({symbol, total_days});
+    }
+    return load(requests, timeframe);
+}
+
+std::unordered_map<std::string, std::vector<quantlab::core::Bar>> MultiSymbolLoader::load(
+    const std::vector<LoadRequest>& requests,
+    const std::string& timeframe) {
+    
+    std::cout << "📥 Loading " << requests.size() << " symbols with up to "
+              << max_concurrency_ << " concurrent requests" << std::endl;
+    auto start_time = std::chrono::steady_clock::now();
+    
+    // One slot per symbol so workers never contend on the result container
+    std::vector<std::vector<quantlab::core::Bar>> per_symbol(requests.size());
+    
+    quantlab::core::parallel_for(requests.size(), max_concurrency_, [&](size_t i) {
+        try {
+            per_symbol[i] = client_.get_aggregated_historical_bars(requests[i].symbol, timeframe,
+                                                                   requests[i].total_days);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Failed to load " << requests[i].symbol << ": " << e.what() << std::endl;
+        }
+    });
+    
+    std::unordered_map<std::string, std::vector<quantlab::core::Bar>> result;
+    result.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        result[requests[i].symbol] = std::move(per_symbol[i]);
+    }
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    std::cout << "✅ Loaded " << requests.size() << " symbols in " << elapsed << " ms" << std::endl;
+    
+    return result;
+}
+
+} // namespace quantlab::data
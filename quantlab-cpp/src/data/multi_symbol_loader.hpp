@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "alpaca_client.hpp"
+
+namespace quantlab::data {
+
+/**
+ * One symbol's history request (window length in calendar days)
+ */
+struct LoadRequest {
+    std::string symbol;
+    int total_days;
+};
+
+/**
+ * Concurrent historical data loader for a universe of symbols
+ *
+ * Each worker runs the source's normal path for one symbol at a time (for
+ * AlpacaClient: cached and paginated). Request pacing is global: every
+ * AlpacaClient worker draws from the process-wide token bucket in
+ * alpaca_rate_limiter(), so raising the concurrency fills the API budget
+ * without ever exceeding it.
+ */
+class MultiSymbolLoader {
+private:
+    DataSource& client_;
+    size_t max_concurrency_;
+
+public:
+    explicit MultiSymbolLoader(DataSource& client, size_t max_concurrency = 8)
+        : client_(client), max_concurrency_(max_concurrency) {}
+
+    // Returns chronological bars per symbol (symbols that failed map to an empty vector)
+    std::unordered_map<std::string, std::vector<quantlab::core::Bar>> load(
+        const std::vector<std::string>& symbols,
+        const std::string& timeframe = "1Day",
+        int total_days = 250
+    );
+    
+    // Per-symbol window lengths; results are keyed by symbol
+    std::unordered_map<std::string, std::vector<quantlab::core::Bar>> load(
+        const std::vector<LoadRequest>& requests,
+        const std::string& timeframe = "1Day"
+    );
+};
+
+} // namespace quantlab::data
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+
+namespace quantlab::data {
+
+/**
+ * Thread-safe token bucket rate limiter
+ *
+ * Callers reserve a token under the lock and sleep outside it, so concurrent
+ * requests are admitted in arrival order without holding the mutex while waiting.
+ * Any 60-second window admits at most burst + rate * 60 requests, which is how
+ * the Alpaca budget is kept below the 429 threshold.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket(double tokens_per_second, double burst)
+        : rate_(tokens_per_second), burst_(burst), tokens_(burst), last_refill_(Clock::now()),
+          paused_until_(Clock::now()) {}
+
+    // Block until a request may be sent
+    void acquire() {
+        std::this_thread::sleep_until(reserve());
+    }
+
+    // Stop admitting requests for `duration` (e.g. after the server answered 429)
+    void pause(std::chrono::milliseconds duration) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_until_ = std::max(paused_until_, Clock::now() + duration);
+    }
+
+    double tokens_per_second() const { return rate_; }
+    double burst() const { return burst_; }
+
+private:
+    double rate_;
+    double burst_;
+    double tokens_;                  // May go negative: outstanding reservations
+    Clock::time_point last_refill_;
+    Clock::time_point paused_until_;
+    std::mutex mutex_;
+
+    // Take one token and return the moment it becomes usable
+    Clock::time_point reserve() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+
+        double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+        tokens_ = std::min(burst_, tokens_ + elapsed * rate_);
+        last_refill_ = now;
+
+        tokens_ -= 1.0;
+        auto start = std::max(now, paused_until_);
+        if (tokens_ >= 0.0) {
+            return start;
+        }
+        auto wait = std::chrono::duration<double>(-tokens_ / rate_);
+        return start + std::chrono::duration_cast<Clock::duration>(wait);
+    }
+};
+
+/**
+ * Process-wide limiter shared by every AlpacaClient request
+ *
+ * Defaults to the free plan (200 calls/minute); set ALPACA_RATE_LIMIT_PER_MINUTE
+ * for paid plans. A small burst is carved out of the budget so that burst plus
+ * sustained rate never exceeds the per-minute limit.
+ */
+inline TokenBucket& alpaca_rate_limiter() {
+    static TokenBucket limiter = [] {
+        double per_minute = 200.0;  // Free plan limit
+        if (const char* env = std::getenv("ALPACA_RATE_LIMIT_PER_MINUTE")) {
+            double value = std::atof(env);
+            if (value > 0.0) per_minute = value;
+        }
+        double burst = std::max(1.0, per_minute * 0.05);
+        // At least one call per minute: limits of 1 or below would leave no sustained rate
+        // (and reserve() dividing by it), so they get one burst call plus one a minute
+        return TokenBucket(std::max(per_minute - burst, 1.0) / 60.0, burst);
+    }();
+    return limiter;
+}
+
+} // namespace quantlab::data
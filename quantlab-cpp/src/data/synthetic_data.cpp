@@ -0,0 +1,207 @@
+#include "synthetic_data.hpp"
+#include "alpaca_client.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <charconv>
+
+namespace quantlab::data {
+
+const char* synthetic_model_name(SyntheticModel model) {
+    switch (model) {
+        case SyntheticModel::GBM: return "gbm";
+        case SyntheticModel::ORNSTEIN_UHLENBECK: return "ou";
+        case SyntheticModel::REGIME_SWITCHING: return "regime";
+    }
+    return "unknown";
+}
+
+std::optional<SyntheticModel> parse_synthetic_model(const std::string& name) {
+    if (name == "gbm") return SyntheticModel::GBM;
+    if (name == "ou") return SyntheticModel::ORNSTEIN_UHLENBECK;
+    if (name == "regime") return SyntheticModel::REGIME_SWITCHING;
+    return std::nullopt;
+}
+
+SyntheticBarGenerator::SyntheticBarGenerator(const SyntheticConfig& config)
+    : config_(config), rng_(config.seed), log_price_(std::log(config.start_price)), price_(config.start_price) {
+    const double dt = 1.0 / config.bars_per_year;
+    const double sqrt_dt = std::sqrt(dt);
+
+    calm_step_drift_ = (config.drift - 0.5 * config.volatility * config.volatility) * dt;
+    calm_step_vol_ = config.volatility * sqrt_dt;
+    stressed_step_drift_ = (config.stressed_drift - 0.5 * config.stressed_volatility * config.stressed_volatility) * dt;
+    stressed_step_vol_ = config.stressed_volatility * sqrt_dt;
+
+    // x' = m + (x - m) e^(-kappa dt) + sigma sqrt((1 - e^(-2 kappa dt)) / (2 kappa)) Z
+    const double kappa = config.reversion_speed;
+    ou_decay_ = std::exp(-kappa * dt);
+    ou_step_vol_ = kappa > 0.0 ? config.volatility * std::sqrt((1.0 - ou_decay_ * ou_decay_) / (2.0 * kappa))
+                               : calm_step_vol_;
+    log_long_run_ = std::log(config.long_run_price);
+
+    p_enter_stress_ = 1.0 / std::max(1.0, config.calm_duration_bars);
+    p_leave_stress_ = 1.0 / std::max(1.0, config.stressed_duration_bars);
+}
+
+void SyntheticBarGenerator::generate(quantlab::core::BarColumns& out, size_t count, int64_t start_ns,
+                                     int64_t interval_ns) {
+    out.reserve(out.size() + count);
+    int64_t timestamp_ns = start_ns;
+    for (size_t i = 0; i < count; ++i, timestamp_ns += interval_ns) {
+        append(out, timestamp_ns);
+    }
+}
+
+quantlab::core::BarColumns generate_bars(const SyntheticConfig& config, size_t count, int64_t start_ns,
+                                         int64_t interval_ns) {
+    quantlab::core::BarColumns bars;
+    SyntheticBarGenerator(config).generate(bars, count, start_ns, interval_ns);
+    return bars;
+}
+
+quantlab::core::BarColumns driftless_gbm_bars(size_t count, uint64_t seed) {
+    SyntheticConfig config;
+    config.seed = seed;
+    config.drift = 0.0002;  // = sigma^2 / 2 per bar
+    config.volatility = 0.02;
+    config.bars_per_year = 1.0;
+    return generate_bars(config, count);
+}
+
+namespace {
+
+// Epoch day 0 (1970-01-01) was a Thursday
+bool is_weekday(int32_t epoch_day) {
+    int32_t weekday = (epoch_day + 4) % 7;  // 0 = Sunday
+    if (weekday < 0) weekday += 7;
+    return weekday != 0 && weekday != 6;
+}
+
+} // namespace
+
+std::optional<int> SyntheticDataSource::timeframe_minutes(const std::string& timeframe) {
+    int count = 0;
+    const char* begin = timeframe.data();
+    const char* end = begin + timeframe.size();
+    auto [unit, ec] = std::from_chars(begin, end, count);
+    if (ec != std::errc() || count <= 0) return std::nullopt;
+
+    std::string_view suffix(unit, static_cast<size_t>(end - unit));
+    if (suffix == "Day" && count == 1) return 0;
+    if (suffix == "Min" && count <= SESSION_MINUTES) return count;
+    if (suffix == "Hour" && count * 60 <= SESSION_MINUTES) return count * 60;
+    return std::nullopt;
+}
+
+SyntheticConfig SyntheticDataSource::config_for(const std::string& symbol, const std::string& timeframe) const {
+    // FNV-1a of "SYMBOL/timeframe", folded into the seed
+    uint64_t hash = 1469598103934665603ULL;
+    for (char c : symbol + "/" + timeframe) hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    SyntheticConfig config = config_;
+    uint64_t mix = config_.seed ^ hash;
+    config.seed = SyntheticRng::splitmix64(mix);
+    return config;
+}
+
+quantlab::core::BarColumns SyntheticDataSource::generate_window(const std::string& symbol,
+                                                                const std::string& timeframe,
+                                                                int32_t first_day, int32_t last_day) const {
+    quantlab::core::BarColumns bars;
+    auto minutes = timeframe_minutes(timeframe);
+    if (!minutes) {
+        std::cerr << "❌ Error: Unsupported synthetic timeframe " << timeframe
+                  << " (use 1Day, <n>Min or <n>Hour)" << std::endl;
+        return bars;
+    }
+    first_day = std::max(first_day, origin_day_);
+    if (last_day < first_day) return bars;
+
+    const int64_t interval_ns = static_cast<int64_t>(*minutes) * 60 * quantlab::core::NANOS_PER_SECOND;
+    const int64_t bars_per_day = *minutes == 0 ? 1 : SESSION_MINUTES / *minutes;
+    const int64_t session_start_ns = *minutes == 0 ? 0 : SESSION_OPEN_NS;
+    bars.reserve(static_cast<size_t>((last_day - first_day + 1) * bars_per_day));
+
+    SyntheticBarGenerator generator(config_for(symbol, timeframe));
+    for (int32_t day = origin_day_; day <= last_day; ++day) {
+        if (!is_weekday(day)) continue;
+        const int64_t day_start_ns = static_cast<int64_t>(day) * quantlab::core::NANOS_PER_DAY + session_start_ns;
+        for (int64_t slot = 0; slot < bars_per_day; ++slot) {
+            if (day < first_day) generator.skip();
+            else generator.append(bars, day_start_ns + slot * interval_ns);
+        }
+    }
+    return bars;
+}
+
+bool SyntheticDataSource::test_connection() {
+    std::cout << "🧪 Synthetic market data (" << synthetic_model_name(config_.model) << ", seed " << config_.seed
+              << ") - no API access" << std::endl;
+    return true;
+}
+
+quantlab::core::BarColumns SyntheticDataSource::get_historical_bar_columns(
+    const std::string& symbol,
+    const std::string& timeframe,
+    const std::string& start_date,
+    const std::string& end_date) {
+
+    const int32_t last_day = end_date.empty()
+        ? quantlab::core::today_epoch_day() - AlpacaClient::HISTORY_LAG_DAYS
+        : quantlab::core::epoch_day_from_date(end_date);
+    const int32_t first_day = start_date.empty()
+        ? last_day - DEFAULT_WINDOW_DAYS + 1
+        : quantlab::core::epoch_day_from_date(start_date);
+    return generate_window(symbol, timeframe, first_day, last_day);
+}
+
+std::vector<quantlab::core::Bar> SyntheticDataSource::get_aggregated_historical_bars(
+    const std::string& symbol,
+    const std::string& timeframe,
+    int total_days,
+    int /*days_per_call*/) {
+
+    // Same window as AlpacaClient::get_aggregated_historical_bars
+    const int32_t first_day = AlpacaClient::aggregated_window_first_day(total_days);
+    auto columns = generate_window(symbol, timeframe, first_day, first_day + total_days - 1);
+
+    std::vector<quantlab::core::Bar> bars;
+    bars.reserve(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        bars.push_back(columns.bar(i));
+        bars.back().timestamp = quantlab::core::format_iso8601(bars.back().timestamp_ns);
+    }
+    std::cout << "Collected " << bars.size() << " synthetic bars from " << total_days << " day period" << std::endl;
+    return bars;
+}
+
+std::optional<quantlab::core::Quote> SyntheticDataSource::get_latest_quote(const std::string& symbol) {
+    const int32_t today = quantlab::core::today_epoch_day();
+    auto bars = generate_window(symbol, "1Day", today - 7, today);  // A week always holds a weekday
+    if (bars.empty()) return std::nullopt;
+
+    const double mid = bars.close().back();
+    return quantlab::core::Quote(symbol, quantlab::core::format_iso8601(bars.timestamp_ns().back()),
+                                 mid * (1.0 - 0.00025), mid * (1.0 + 0.00025), 100, 100);
+}
+
+std::shared_ptr<DataSource> make_data_source_from_env() {
+    const char* source = std::getenv("QUANTLAB_DATA_SOURCE");
+    if (!source || std::string(source) != "synthetic") {
+        return std::make_shared<AlpacaClient>();
+    }
+
+    SyntheticConfig config;
+    if (const char* seed = std::getenv("QUANTLAB_SYNTHETIC_SEED")) {
+        config.seed = std::strtoull(seed, nullptr, 10);
+    }
+    if (const char* model = std::getenv("QUANTLAB_SYNTHETIC_MODEL")) {
+        if (auto parsed = parse_synthetic_model(model)) {
+            config.model = *parsed;
+        } else {
+            std::cerr << "⚠️  Unknown QUANTLAB_SYNTHETIC_MODEL " << model << " - using gbm" << std::endl;
+        }
+    }
+    return std::make_shared<SyntheticDataSource>(config);
+}
+
+} // namespace quantlab::data
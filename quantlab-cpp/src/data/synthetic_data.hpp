@@ -0,0 +1,266 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <algorithm>
+#include "../core/data_types.hpp"
+#include "../core/time_utils.hpp"
+#include "data_source.hpp"
+
+namespace quantlab::data {
+
+/**
+ * Price process behind a synthetic series
+ */
+enum class SyntheticModel {
+    GBM,                 // Geometric Brownian motion: d ln S = (mu - sigma^2/2) dt + sigma dW
+    ORNSTEIN_UHLENBECK,  // Mean-reverting log price: d ln S = kappa (ln L - ln S) dt + sigma dW
+    REGIME_SWITCHING     // GBM whose (mu, sigma) follow a two-state calm / stressed Markov chain
+};
+
+const char* synthetic_model_name(SyntheticModel model);
+std::optional<SyntheticModel> parse_synthetic_model(const std::string& name);  // "gbm" | "ou" | "regime"
+
+/**
+ * Parameters of a synthetic series
+ *
+ * Drift and volatility are annualized and bars_per_year turns them into
+ * per-bar steps (set it to 1 to give per-bar values directly). In the
+ * regime model, drift / volatility describe the calm state.
+ */
+struct SyntheticConfig {
+    SyntheticModel model = SyntheticModel::GBM;
+    uint64_t seed = 42;
+    double start_price = 100.0;
+    double drift = 0.08;
+    double volatility = 0.25;
+    double bars_per_year = 252.0;
+
+    // Ornstein-Uhlenbeck
+    double reversion_speed = 8.0;       // kappa per year (half-life ln2 / kappa)
+    double long_run_price = 100.0;
+
+    // Regime switching: mean length of each state in bars (geometric durations)
+    double stressed_drift = -0.30;
+    double stressed_volatility = 0.45;
+    double calm_duration_bars = 250.0;
+    double stressed_duration_bars = 40.0;
+
+    double intrabar_range = 0.5;        // High / low extend up to this many per-bar sigmas past open / close
+    double volume_mean = 1'000'000.0;   // Volume also scales with the size of the move
+};
+
+/**
+ * Seeded generator for synthetic streams: xoshiro256** seeded through
+ * splitmix64, Box-Muller normals
+ *
+ * Implemented here rather than with <random> distributions, whose output
+ * is implementation-defined: a seed gives the same draws with any
+ * standard library (the prices only as exact as the platform's exp/log).
+ */
+class SyntheticRng {
+private:
+    uint64_t state_[4];
+    double spare_normal_ = 0.0;
+    bool has_spare_ = false;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    explicit SyntheticRng(uint64_t seed) {
+        for (auto& word : state_) word = splitmix64(seed);
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1) with 53 random bits
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Standard normal; draws come in Box-Muller pairs, the second is kept for the next call
+    double normal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_normal_;
+        }
+        const double u1 = 1.0 - uniform();  // (0, 1], log stays finite
+        const double u2 = uniform();
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        const double angle = 2.0 * std::numbers::pi * u2;
+        spare_normal_ = radius * std::sin(angle);
+        has_spare_ = true;
+        return radius * std::cos(angle);
+    }
+};
+
+/**
+ * Streams bars of one synthetic series straight into BarColumns
+ *
+ * Each bar opens at the previous close (no gaps); high / low add a
+ * random excursion of up to intrabar_range per-bar sigmas beyond the
+ * open-close body. The same config produces the same bars, and skip()
+ * advances the path without storing, so windows of one long series can
+ * be cut out reproducibly.
+ */
+class SyntheticBarGenerator {
+private:
+    SyntheticConfig config_;
+    SyntheticRng rng_;
+    double log_price_;
+    double price_;  // exp(log_price_), carried over as the next bar's open
+    bool stressed_ = false;
+
+    // Per-bar constants
+    double calm_step_drift_, calm_step_vol_;
+    double stressed_step_drift_, stressed_step_vol_;
+    double ou_decay_, ou_step_vol_, log_long_run_;
+    double p_enter_stress_, p_leave_stress_;
+
+    // One step of the log price; returns the normalized shock
+    double step() {
+        const double z = rng_.normal();
+        switch (config_.model) {
+            case SyntheticModel::GBM:
+                log_price_ += calm_step_drift_ + calm_step_vol_ * z;
+                break;
+            case SyntheticModel::ORNSTEIN_UHLENBECK:
+                // Exact discretization: stable for any kappa * dt
+                log_price_ = log_long_run_ + (log_price_ - log_long_run_) * ou_decay_ + ou_step_vol_ * z;
+                break;
+            case SyntheticModel::REGIME_SWITCHING:
+                if (rng_.uniform() < (stressed_ ? p_leave_stress_ : p_enter_stress_)) stressed_ = !stressed_;
+                log_price_ += stressed_ ? stressed_step_drift_ + stressed_step_vol_ * z
+                                        : calm_step_drift_ + calm_step_vol_ * z;
+                break;
+        }
+        return z;
+    }
+
+    double step_vol() const {
+        if (config_.model == SyntheticModel::REGIME_SWITCHING && stressed_) return stressed_step_vol_;
+        return config_.model == SyntheticModel::ORNSTEIN_UHLENBECK ? ou_step_vol_ : calm_step_vol_;
+    }
+
+public:
+    explicit SyntheticBarGenerator(const SyntheticConfig& config);
+
+    // Append one bar stamped timestamp_ns
+    void append(quantlab::core::BarColumns& out, int64_t timestamp_ns) {
+        const double open = price_;
+        const double z = step();
+        const double close = price_ = std::exp(log_price_);
+        const double range = config_.intrabar_range * step_vol();
+        const double high = std::max(open, close) * (1.0 + range * rng_.uniform());
+        const double low = std::min(open, close) * (1.0 - range * rng_.uniform());
+        const double volume = config_.volume_mean * (0.5 + rng_.uniform()) * (1.0 + std::abs(z));
+        out.push_back(timestamp_ns, open, high, low, close, static_cast<int64_t>(volume));
+    }
+
+    // Advance by one bar without storing it (consumes the same draws as append)
+    void skip() {
+        step();
+        price_ = std::exp(log_price_);
+        rng_.uniform();
+        rng_.uniform();
+        rng_.uniform();
+    }
+
+    // Append count bars at start_ns, start_ns + interval_ns, ...
+    void generate(quantlab::core::BarColumns& out, size_t count, int64_t start_ns, int64_t interval_ns);
+
+    double price() const { return price_; }
+    bool stressed() const { return stressed_; }
+};
+
+// count one-minute bars (by default) of a fresh series
+quantlab::core::BarColumns generate_bars(const SyntheticConfig& config, size_t count, int64_t start_ns = 0,
+                                         int64_t interval_ns = 60 * quantlab::core::NANOS_PER_SECOND);
+
+// Benchmark fixture shared by quantlab_bench and strategy_benchmark: seeded GBM with per-bar
+// parameters (bars_per_year = 1), 2% volatility per bar and no log drift. Only the timestamps
+// are one minute apart; the moves are not scaled to one-minute returns.
+quantlab::core::BarColumns driftless_gbm_bars(size_t count, uint64_t seed = 42);
+
+/**
+ * Offline DataSource serving synthetic series on a trading calendar
+ *
+ * Every (symbol, timeframe) pair is one deterministic path that starts at
+ * origin_day. The seed is mixed with both, so series differ but a rerun,
+ * another process or a later catch_up() sees the same bars:
+ *
+ *   - "1Day": one bar per weekday, stamped at UTC midnight;
+ *   - "<n>Min" / "<n>Hour": the 13:30-20:00 UTC session of every weekday.
+ *
+ * A request regenerates the path from origin_day up to its end date and
+ * keeps the requested part. That is cheap at millions of bars per second,
+ * and nothing is stored between calls, so concurrent loads are safe.
+ * Windows match AlpacaClient's: they end HISTORY_LAG_DAYS before today.
+ */
+class SyntheticDataSource : public DataSource {
+private:
+    SyntheticConfig config_;
+    int32_t origin_day_;
+
+    static constexpr int64_t SESSION_OPEN_NS = (13 * 60 + 30) * 60 * quantlab::core::NANOS_PER_SECOND;
+    static constexpr int64_t SESSION_MINUTES = 390;
+
+    // Bars of the symbol's path on days [first_day, last_day]; empty on an unknown timeframe
+    quantlab::core::BarColumns generate_window(const std::string& symbol, const std::string& timeframe,
+                                               int32_t first_day, int32_t last_day) const;
+
+public:
+    static constexpr int32_t DEFAULT_ORIGIN_DAY = quantlab::core::days_from_civil(2015, 1, 1);
+    static constexpr int DEFAULT_WINDOW_DAYS = 365;  // Requests without a start date
+
+    explicit SyntheticDataSource(SyntheticConfig config = {}, int32_t origin_day = DEFAULT_ORIGIN_DAY)
+        : config_(config), origin_day_(origin_day) {}
+
+    const SyntheticConfig& config() const { return config_; }
+
+    // Bar interval in minutes for "1Day" (0), "<n>Min" and "<n>Hour"; nullopt if unsupported
+    static std::optional<int> timeframe_minutes(const std::string& timeframe);
+
+    // The config a series is generated with (seed mixed with symbol and timeframe)
+    SyntheticConfig config_for(const std::string& symbol, const std::string& timeframe) const;
+
+    bool test_connection() override;
+
+    quantlab::core::BarColumns get_historical_bar_columns(
+        const std::string& symbol,
+        const std::string& timeframe = "1Day",
+        const std::string& start_date = "",
+        const std::string& end_date = ""
+    ) override;
+
+    std::vector<quantlab::core::Bar> get_aggregated_historical_bars(
+        const std::string& symbol,
+        const std::string& timeframe = "1Day",
+        int total_days = 250,
+        int days_per_call = 1
+    ) override;
+
+    // Last daily close up to today, with a 5 bp spread around it
+    std::optional<quantlab::core::Quote> get_latest_quote(const std::string& symbol) override;
+};
+
+} // namespace quantlab::data
@@ -1,8 +1,12 @@
 #pragma once
 #include <vector>
-#include <deque>
+#include <span>
 #include <cmath>
-#include <numeric>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include "../core/simd.hpp"
+#include "../core/state_io.hpp"
 
 namespace quantlab::indicators {
 
@@ -31,68 +35,148 @@ private:
     // - What multiplier for standard deviation? (typical: 2.0)
     double std_dev_multiplier_;
     // - How to store the recent price history?
-    std::deque<double> price_history_;
+    //   Fixed-capacity ring buffer plus running statistics, so each update is O(1)
+    //   regardless of period (see SlidingWindowStats below)
+    struct SlidingWindowStats {
+        std::vector<double> window;  // One contiguous allocation, oldest price overwritten in place
+        size_t head = 0;             // Slot the next price is written to (= oldest price once full)
+        size_t count = 0;            // Prices currently in the window (<= capacity)
+        double mean = 0.0;           // Running mean of the window (Welford)
+        double m2 = 0.0;             // Running sum of squared deviations from the mean
+        
+        explicit SlidingWindowStats(int period) : window(static_cast<size_t>(period > 0 ? period : 1), 0.0) {}
+        
+        bool full() const { return count == window.size(); }
+        
+        void push(double price) {
+            const size_t capacity = window.size();
+            if (count < capacity) {
+                // Window still filling: standard Welford insertion
+                window[head] = price;
+                head = (head + 1) % capacity;
+                ++count;
+                
+                welford_insert(mean, m2, price, count);
+            } else {
+                // Window full: the new price replaces the oldest one in place
+                double oldest = window[head];
+                window[head] = price;
+                head = (head + 1) % capacity;
+                
+                welford_slide(mean, m2, price, oldest, count);
+                
+                // Once per full revolution, rebuild the sums exactly (amortized O(1))
+                // so rounding error cannot accumulate over millions of ticks
+                if (head == 0) {
+                    renormalize();
+                }
+            }
+        }
+        
+        // Recompute mean/M2 exactly from the window (two-pass) to discard accumulated rounding drift
+        void renormalize() {
+            // Called when head == 0, so slot order is oldest -> newest
+            exact_stats(mean, m2, std::span<const double>(window.data(), count));
+        }
+        
+        void clear() {
+            head = 0;
+            count = 0;
+            mean = 0.0;
+            m2 = 0.0;
+        }
+    };
+    SlidingWindowStats stats_;
     // - Current calculated bands?
     BollingerBandsResult current_bands_;
     // - Initialization state?
     bool initialized_;
-    // TODO: Add your member variables here
-    // HINT: Unlike EMA/RSI, you need to store multiple prices
 
 public:
+    // Welford building blocks, shared with IndicatorBank so every lane rounds exactly like update()
+    
+    // Add a price to a window that now holds `count` prices
+    static void welford_insert(double& mean, double& m2, double price, size_t count) {
+        double delta = price - mean;
+        mean += delta / count;
+        m2 += delta * (price - mean);
+    }
+    
+    // Replace the oldest price of a full window of `count` prices:
+    //   mean' = mean + (x_new - x_old) / N
+    //   M2'   = M2 + (x_new - x_old) * (x_new - mean' + x_old - mean)
+    static void welford_slide(double& mean, double& m2, double price, double oldest, size_t count) {
+        double old_mean = mean;
+        double delta = price - oldest;
+        mean += delta / count;
+        m2 += delta * (price - mean + oldest - old_mean);
+    }
+    
+    // Exact two-pass mean/M2 over a window stored oldest first
+    static void exact_stats(double& mean, double& m2, std::span<const double> prices) {
+        const size_t count = prices.size();
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) sum += prices[i];
+        mean = sum / count;
+        double variance_sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double diff = prices[i] - mean;
+            variance_sum += diff * diff;
+        }
+        m2 = variance_sum;
+    }
+    
+    // Bands from a full window's running statistics
+    static BollingerBandsResult bands_from(double mean, double m2, int period, double std_dev_multiplier) {
+        double variance = m2 > 0.0 ? m2 / period : 0.0;  // Guard tiny negative rounding
+        double std_dev = std::sqrt(variance);
+        return BollingerBandsResult{
+            mean + std_dev_multiplier * std_dev,   // Resistance level
+            mean,                                  // The trend line
+            mean - std_dev_multiplier * std_dev    // Support level
+        };
+    }
+    
     // QUESTION 3: Constructor
     // What parameters should it take?
     // How do you initialize the member variables?
-    explicit BollingerBands(int period = 20, double std_dev_multiplier = 2.0):period_(period), std_dev_multiplier_(std_dev_multiplier), current_bands_{0.0, 0.0, 0.0}, initialized_(false) {
-        // TODO: Initialize your member variables
+    explicit BollingerBands(int period = 20, double std_dev_multiplier = 2.0)
+        : period_(period), std_dev_multiplier_(std_dev_multiplier),
+          stats_(period), current_bands_{0.0, 0.0, 0.0}, initialized_(false) {
     }
     
     // QUESTION 4: The core algorithm - this is where the learning happens!
     BollingerBandsResult update(double price) {
-        // ===== STEP 1: PRICE HISTORY MANAGEMENT =====
-        // Add the newest price to our rolling window
-        // This creates a "sliding window" of the most recent N prices
-        price_history_.push_back(price);
+        // ===== STEP 1 + 2: ROLLING WINDOW WITH RUNNING STATISTICS =====
+        // Instead of re-summing the whole window every tick (O(period)), keep a running
+        // mean and M2 = sum((xi - mean)^2) and adjust them for the price that enters
+        // and the price that leaves. A 200-period band then costs the same as a 20-period one.
+        stats_.push(price);
         
-        // ===== STEP 2: MAINTAIN ROLLING WINDOW =====
-        // Keep only the last 'period_' prices (e.g., last 20 prices)
-        // Remove oldest price when we have too many
-        // Example: If period=20 and we have 21 prices, remove the oldest
-        if(price_history_.size() > static_cast<size_t>(period_))
-            price_history_.pop_front();  // Remove from front (oldest price)
-            
         // ===== STEP 3: DATA VALIDATION =====
         // Need at least 'period_' prices for valid Bollinger Bands calculation
         // Example: For 20-period bands, need at least 20 price points
-        if(price_history_.size() < static_cast<size_t>(period_))
+        if (!stats_.full())
             return BollingerBandsResult{0.0, 0.0, 0.0}; // Not enough data yet
-        // ===== STEP 4: CALCULATE SIMPLE MOVING AVERAGE (SMA) =====
-        // SMA = (sum of all prices) / number of prices
+        
+        // ===== STEP 4: SIMPLE MOVING AVERAGE (SMA) =====
+        // SMA = (sum of all prices) / number of prices = the running mean
         // Example: prices [90, 95, 100, 105, 110] → SMA = 500/5 = 100
         // This is the MIDDLE BAND of Bollinger Bands
-        // Unlike EMA, SMA gives equal weight to all prices in the window
-        double sma = std::accumulate(price_history_.begin(), price_history_.end(), 0.0) / period_;
-        // ===== STEP 5: CALCULATE STANDARD DEVIATION (VOLATILITY MEASURE) =====
-        // Standard deviation measures how "spread out" prices are from the average
-        // Formula: σ = sqrt(Σ(xi - μ)² / n)
-        // 
+        double sma = stats_.mean;
+        
+        // ===== STEP 5: STANDARD DEVIATION (VOLATILITY MEASURE) =====
+        // Formula: σ = sqrt(Σ(xi - μ)² / n) = sqrt(M2 / n)
+        //
         // LOW std_dev = prices close to average = LOW VOLATILITY = tight bands
         // HIGH std_dev = prices far from average = HIGH VOLATILITY = wide bands
         //
         // Example with prices [90, 95, 100, 105, 110] and SMA=100:
-        // Differences: [-10, -5, 0, +5, +10]
-        // Squared: [100, 25, 0, 25, 100] → Sum = 250
+        // Squared deviations: [100, 25, 0, 25, 100] → M2 = 250
         // Variance = 250/5 = 50 → std_dev = sqrt(50) ≈ 7.07
+        // (see bands_from(); a tiny negative M2 from rounding is treated as zero)
         
-        double variance_sum = 0.0;
-        for (double p : price_history_) {
-            double diff = p - sma;              // How far is this price from average?
-            variance_sum += diff * diff;        // Square it (removes negatives, emphasizes larger moves)
-        }
-        double std_dev = std::sqrt(variance_sum / period_);  // Take square root to get standard deviation
         // ===== STEP 6: CALCULATE THE THREE BOLLINGER BANDS =====
-        // The three bands create a "channel" around price action
-        // 
         // MIDDLE BAND = Simple Moving Average (trend direction)
         // UPPER BAND = SMA + (k × std_dev) [typically k=2.0 for ~95% confidence]
         // LOWER BAND = SMA - (k × std_dev)
@@ -100,7 +184,6 @@ public:
         // TRADING INTERPRETATION:
         // • Price near UPPER band = potentially OVERBOUGHT (consider selling)
         // • Price near LOWER band = potentially OVERSOLD (consider buying)  
-        // • Price at MIDDLE band = neutral/trend-following
         // • Bands NARROW = low volatility, potential breakout coming
         // • Bands WIDE = high volatility, market is moving strongly
         //
@@ -108,9 +191,7 @@ public:
         // → Upper = 100 + (2.0 × 7.07) = 114.14
         // → Lower = 100 - (2.0 × 7.07) = 85.86
         
-        current_bands_.middle_band = sma;                                    // The trend line
-        current_bands_.upper_band = sma + std_dev_multiplier_ * std_dev;     // Resistance level
-        current_bands_.lower_band = sma - std_dev_multiplier_ * std_dev;     // Support level
+        current_bands_ = bands_from(sma, stats_.m2, period_, std_dev_multiplier_);
         
         initialized_ = true;
         return current_bands_;  // Return all three bands for analysis
@@ -118,18 +199,105 @@ public:
     
     // QUESTION 5: Utility methods
     const BollingerBandsResult& value() const {
-        // TODO: Return current bands
         return current_bands_;
     }
     
     bool is_initialized() const {
-        // TODO: When do you have enough data for valid calculation?
         return initialized_;
     }
     
+    int period() const { return period_; }
+    double std_dev_multiplier() const { return std_dev_multiplier_; }
+    
+    // Snapshot for incremental runs. The ring buffer is stored as-is (slot order plus
+    // head) together with the running mean/M2, so a restored indicator renormalizes on
+    // the same bar and rounds exactly like one that never stopped.
+    void save_state(quantlab::core::StateWriter& out) const {
+        out.write<int32_t>(period_);
+        out.write(std_dev_multiplier_);
+        out.write_doubles(stats_.window);
+        out.write<uint64_t>(stats_.head);
+        out.write<uint64_t>(stats_.count);
+        out.write(stats_.mean);
+        out.write(stats_.m2);
+        out.write(current_bands_);
+        out.write_bool(initialized_);
+    }
+    
+    // Restores on success only; the snapshot must come from the same period and multiplier
+    bool load_state(quantlab::core::StateReader& in) {
+        int32_t period = 0;
+        double multiplier = 0.0;
+        SlidingWindowStats stats(period_);
+        uint64_t head = 0, count = 0;
+        BollingerBandsResult bands{0.0, 0.0, 0.0};
+        bool initialized = false;
+        if (!in.read(period) || !in.read(multiplier) || !in.read_doubles(stats.window) ||
+            !in.read(head) || !in.read(count) || !in.read(stats.mean) || !in.read(stats.m2) ||
+            !in.read(bands) || !in.read_bool(initialized)) {
+            return false;
+        }
+        if (period != period_ || multiplier != std_dev_multiplier_ || stats.window.size() != stats_.window.size() ||
+            head >= stats.window.size() || count > stats.window.size()) {
+            return in.fail();
+        }
+        stats.head = static_cast<size_t>(head);
+        stats.count = static_cast<size_t>(count);
+        stats_ = std::move(stats);
+        current_bands_ = bands;
+        initialized_ = initialized;
+        return true;
+    }
+    
+    // Batch mode: bands for a whole series, as if update() were called on a freshly reset indicator.
+    // The running mean/M2 recurrence is serial and shared with update(), so the middle band is
+    // bit-identical. The variance, sqrt and band offsets are computed SIMD-wide; upper/lower can
+    // differ from update() by 1 ulp where the compiler fuses the scalar multiply-add into an FMA.
+    // Entries before the window fills are {0, 0, 0}, like update(). Object state is untouched.
+    void compute(std::span<const double> in, std::span<double> upper,
+                 std::span<double> middle, std::span<double> lower) const {
+        namespace simd = quantlab::core::simd;
+        assert(upper.size() >= in.size() && middle.size() >= in.size() && lower.size() >= in.size());
+        const size_t n = in.size();
+        const size_t first_full = static_cast<size_t>(period_ > 0 ? period_ : 1) - 1;
+        
+        // STEP 1 (serial): running mean -> middle, running M2 -> upper (scratch)
+        SlidingWindowStats stats(period_);
+        for (size_t i = 0; i < n; ++i) {
+            stats.push(in[i]);
+            middle[i] = stats.mean;
+            upper[i] = stats.m2;
+        }
+        
+        // STEP 2: warm-up entries have no bands yet
+        for (size_t i = 0; i < std::min(first_full, n); ++i) {
+            upper[i] = middle[i] = lower[i] = 0.0;
+        }
+        
+        // STEP 3 (SIMD): std dev and band math
+        const simd::VecD zero = simd::set1(0.0);
+        const simd::VecD period_divisor = simd::set1(static_cast<double>(period_));
+        const simd::VecD k = simd::set1(std_dev_multiplier_);
+        size_t i = first_full;
+        for (; i + simd::WIDTH <= n; i += simd::WIDTH) {
+            simd::VecD m2 = simd::load(&upper[i]);
+            simd::VecD sma = simd::load(&middle[i]);
+            simd::VecD variance = simd::select(simd::cmp_gt(m2, zero), simd::div(m2, period_divisor), zero);
+            simd::VecD offset = simd::mul(k, simd::sqrt(variance));
+            simd::store(&upper[i], simd::add(sma, offset));
+            simd::store(&lower[i], simd::sub(sma, offset));
+        }
+        for (; i < n; ++i) {
+            double variance = upper[i] > 0.0 ? upper[i] / period_ : 0.0;
+            double std_dev = std::sqrt(variance);
+            upper[i] = middle[i] + std_dev_multiplier_ * std_dev;
+            lower[i] = middle[i] - std_dev_multiplier_ * std_dev;
+        }
+    }
+    
     void reset() {
-        // TODO: Clear all state
-        price_history_.clear();
+        // Keep the ring buffer allocation, clear the statistics
+        stats_.clear();
         current_bands_ = {0.0, 0.0, 0.0};
         initialized_ = false;
     }
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "bollinger_bands.hpp"
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+
+namespace quantlab::indicators {
+
+/**
+ * Many EMA / RSI / Bollinger Bands configurations fed from one price stream
+ *
+ * A parameter sweep over ema_period / rsi_period / bb_period would otherwise
+ * replay the same series once per combination. The bank keeps one lane per
+ * distinct period in structure-of-arrays form (alpha[], ema[], rsi[], mean[],
+ * ...), so a single update() advances every lane together and one pass over
+ * the data serves the whole grid.
+ *
+ * - EMA and RSI lanes are independent recurrences; their per-bar loops run
+ *   over contiguous arrays and vectorize across lanes.
+ * - Bollinger lanes share one price history sized to the longest period;
+ *   each lane runs the same sliding Welford update (and periodic
+ *   renormalization) as BollingerBands against that shared history.
+ *
+ * Every lane reproduces the standalone RollingEMA / RSI / BollingerBands
+ * output for the same period. Periods are deduplicated and sorted; look lanes
+ * up with ema_index() / rsi_index() / bb_index().
+ */
+class IndicatorBank {
+private:
+    // EMA lanes
+    std::vector<int> ema_periods_;
+    std::vector<double> ema_alpha_;
+    std::vector<double> ema_;
+
+    // RSI lanes (two EMAs of gains and losses per lane)
+    std::vector<int> rsi_periods_;
+    std::vector<double> rsi_alpha_;
+    std::vector<double> avg_gain_;
+    std::vector<double> avg_loss_;
+    std::vector<double> rsi_;
+
+    // Bollinger lanes over a shared price history
+    std::vector<int> bb_periods_;
+    double bb_std_dev_;
+    std::vector<double> bb_mean_;
+    std::vector<double> bb_m2_;
+    std::vector<double> bb_upper_;
+    std::vector<double> bb_middle_;
+    std::vector<double> bb_lower_;
+    std::vector<double> history_;   // Ring buffer of the last max(bb_periods_) prices, slot = bar index % size
+    std::vector<double> scratch_;   // One window laid out oldest first for renormalization
+
+    double previous_price_;
+    size_t bars_seen_;
+
+    static std::vector<int> unique_periods(std::vector<int> periods) {
+        for (int& p : periods) p = std::max(p, 1);
+        std::sort(periods.begin(), periods.end());
+        periods.erase(std::unique(periods.begin(), periods.end()), periods.end());
+        return periods;
+    }
+
+    static size_t index_of(const std::vector<int>& periods, int period) {
+        auto it = std::lower_bound(periods.begin(), periods.end(), std::max(period, 1));
+        assert(it != periods.end() && *it == std::max(period, 1));
+        return static_cast<size_t>(it - periods.begin());
+    }
+
+    // Price of bar `bar_index` (must be within the last history_.size() bars)
+    double history_at(size_t bar_index) const {
+        return history_[bar_index % history_.size()];
+    }
+
+    // EMA step for every lane, written exactly like RollingEMA::update() so each lane rounds
+    // (and, under -ffp-contract, fuses) the same way; the SoA loop auto-vectorizes across lanes
+    static void ema_step(std::vector<double>& ema, const std::vector<double>& alpha, double x) {
+        const size_t lanes = ema.size();
+        double* __restrict e = ema.data();
+        const double* __restrict a = alpha.data();
+        for (size_t i = 0; i < lanes; ++i) {
+            e[i] = a[i] * x + (1 - a[i]) * e[i];
+        }
+    }
+
+    void update_rsi(double gain, double loss) {
+        if (bars_seen_ == 1) {
+            // First price change seeds both EMAs, like RollingEMA's first update()
+            std::fill(avg_gain_.begin(), avg_gain_.end(), gain);
+            std::fill(avg_loss_.begin(), avg_loss_.end(), loss);
+        } else {
+            ema_step(avg_gain_, rsi_alpha_, gain);
+            ema_step(avg_loss_, rsi_alpha_, loss);
+        }
+
+        // Same zero guards as RSI::update(), branch-free so the lanes vectorize
+        const size_t lanes = rsi_.size();
+        const double* __restrict g = avg_gain_.data();
+        const double* __restrict l = avg_loss_.data();
+        double* __restrict rsi = rsi_.data();
+        for (size_t i = 0; i < lanes; ++i) {
+            double value = 100.0 - (100. / (1.0 + g[i] / l[i]));
+            value = (l[i] == 0.0) ? 100.0 : value;
+            rsi[i] = (l[i] == 0.0 && g[i] == 0.0) ? 50.0 : value;
+        }
+    }
+
+    // Sliding Welford per lane against the shared history (see BollingerBands::SlidingWindowStats)
+    void update_bands(double price) {
+        const size_t t = bars_seen_;  // Index of the bar being added
+
+        for (size_t lane = 0; lane < bb_periods_.size(); ++lane) {
+            const size_t period = static_cast<size_t>(bb_periods_[lane]);
+            if (t < period) {
+                BollingerBands::welford_insert(bb_mean_[lane], bb_m2_[lane], price, t + 1);
+            } else {
+                // Window full: the bar `period` ago leaves as this one enters
+                BollingerBands::welford_slide(bb_mean_[lane], bb_m2_[lane], price, history_at(t - period), period);
+            }
+        }
+
+        history_[t % history_.size()] = price;
+
+        for (size_t lane = 0; lane < bb_periods_.size(); ++lane) {
+            const size_t period = static_cast<size_t>(bb_periods_[lane]);
+            if (t + 1 < period) {
+                bb_upper_[lane] = bb_middle_[lane] = bb_lower_[lane] = 0.0;  // Not enough data yet
+                continue;
+            }
+
+            // BollingerBands renormalizes whenever its own ring head wraps, i.e. every `period` bars once full
+            if (t >= period && (t + 1) % period == 0) {
+                // Same contiguous oldest-first layout BollingerBands sums over
+                const size_t first = t + 1 - period;
+                for (size_t i = 0; i < period; ++i) scratch_[i] = history_at(first + i);
+                BollingerBands::exact_stats(bb_mean_[lane], bb_m2_[lane],
+                                            std::span<const double>(scratch_.data(), period));
+            }
+
+            auto bands = BollingerBands::bands_from(bb_mean_[lane], bb_m2_[lane], bb_periods_[lane], bb_std_dev_);
+            bb_upper_[lane] = bands.upper_band;
+            bb_middle_[lane] = bands.middle_band;
+            bb_lower_[lane] = bands.lower_band;
+        }
+    }
+
+public:
+    IndicatorBank(std::vector<int> ema_periods, std::vector<int> rsi_periods,
+                  std::vector<int> bb_periods, double bb_std_dev = 2.0)
+        : ema_periods_(unique_periods(std::move(ema_periods))),
+          rsi_periods_(unique_periods(std::move(rsi_periods))),
+          bb_periods_(unique_periods(std::move(bb_periods))),
+          bb_std_dev_(bb_std_dev), previous_price_(0.0), bars_seen_(0) {
+        for (int p : ema_periods_) ema_alpha_.push_back(2.0 / (p + 1));
+        for (int p : rsi_periods_) rsi_alpha_.push_back(2.0 / (p + 1));
+        ema_.assign(ema_periods_.size(), 0.0);
+        avg_gain_.assign(rsi_periods_.size(), 0.0);
+        avg_loss_.assign(rsi_periods_.size(), 0.0);
+        rsi_.assign(rsi_periods_.size(), 50.0);
+        bb_mean_.assign(bb_periods_.size(), 0.0);
+        bb_m2_.assign(bb_periods_.size(), 0.0);
+        bb_upper_.assign(bb_periods_.size(), 0.0);
+        bb_middle_.assign(bb_periods_.size(), 0.0);
+        bb_lower_.assign(bb_periods_.size(), 0.0);
+        history_.assign(bb_periods_.empty() ? 1 : static_cast<size_t>(bb_periods_.back()), 0.0);
+        scratch_.assign(history_.size(), 0.0);
+    }
+
+    // Advance every lane by one price
+    void update(double price) {
+        if (bars_seen_ == 0) {
+            // First price seeds the EMAs and previous price; RSI stays neutral
+            std::fill(ema_.begin(), ema_.end(), price);
+        } else {
+            ema_step(ema_, ema_alpha_, price);
+
+            double change = price - previous_price_;
+            double gain = (change > 0) ? change : 0.0;
+            double loss = (change < 0) ? -change : 0.0;
+            update_rsi(gain, loss);
+        }
+        update_bands(price);
+
+        previous_price_ = price;
+        ++bars_seen_;
+    }
+
+    void reset() {
+        std::fill(ema_.begin(), ema_.end(), 0.0);
+        std::fill(avg_gain_.begin(), avg_gain_.end(), 0.0);
+        std::fill(avg_loss_.begin(), avg_loss_.end(), 0.0);
+        std::fill(rsi_.begin(), rsi_.end(), 50.0);
+        std::fill(bb_mean_.begin(), bb_mean_.end(), 0.0);
+        std::fill(bb_m2_.begin(), bb_m2_.end(), 0.0);
+        std::fill(bb_upper_.begin(), bb_upper_.end(), 0.0);
+        std::fill(bb_middle_.begin(), bb_middle_.end(), 0.0);
+        std::fill(bb_lower_.begin(), bb_lower_.end(), 0.0);
+        previous_price_ = 0.0;
+        bars_seen_ = 0;
+    }
+
+    // Lane lookup (the period must have been passed to the constructor)
+    size_t ema_index(int period) const { return index_of(ema_periods_, period); }
+    size_t rsi_index(int period) const { return index_of(rsi_periods_, period); }
+    size_t bb_index(int period) const { return index_of(bb_periods_, period); }
+
+    // Current values per lane
+    double ema(size_t lane) const { return ema_[lane]; }
+    double rsi(size_t lane) const { return rsi_[lane]; }
+    BollingerBandsResult bands(size_t lane) const {
+        return BollingerBandsResult{bb_upper_[lane], bb_middle_[lane], bb_lower_[lane]};
+    }
+
+    const std::vector<int>& ema_periods() const { return ema_periods_; }
+    const std::vector<int>& rsi_periods() const { return rsi_periods_; }
+    const std::vector<int>& bb_periods() const { return bb_periods_; }
+    size_t bars_seen() const { return bars_seen_; }
+};
+
+} // namespace quantlab::indicators
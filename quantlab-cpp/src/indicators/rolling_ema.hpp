@@ -7,6 +7,10 @@
 // Used in MACD, trend identification, support/resistance
 // new price gets weight alpha, previous EMA gets weight (1-alpha)
 // if current_price>EMA → uptrend, else downtrend
+#include <span>
+#include <cassert>
+#include "../core/state_io.hpp"
+
 namespace quantlab::indicators {
 
 class RollingEMA
@@ -44,5 +48,41 @@ public:
     bool is_initialized() const {
         return initialized_;
     }
+    double alpha() const {
+        return alpha_;
+    }
+    // Snapshot for incremental runs. alpha is stored too so a snapshot taken with a
+    // different period is rejected instead of silently resumed.
+    void save_state(quantlab::core::StateWriter& out) const
+    {
+        out.write(alpha_);
+        out.write_bool(initialized_);
+        out.write(current_ema_);
+    }
+    bool load_state(quantlab::core::StateReader& in)
+    {
+        double alpha=0.0, ema=0.0;
+        bool initialized=false;
+        if(!in.read(alpha) || !in.read_bool(initialized) || !in.read(ema)) return false;
+        if(alpha!=alpha_) return in.fail();
+        initialized_=initialized;
+        current_ema_=ema;
+        return true;
+    }
+    // Batch mode: EMA of a whole series, as if update() were called on a freshly reset indicator.
+    // The recurrence is serial by nature, so this is the update() loop with the state in a register;
+    // out[i] is bit-identical to the i-th update(). in and out may alias. Object state is untouched.
+    void compute(std::span<const double> in, std::span<double> out) const
+    {
+        assert(out.size() >= in.size());
+        if(in.empty()) return;
+        double ema=in[0]; // first price becomes initial EMA
+        out[0]=ema;
+        for(size_t i=1;i<in.size();++i)
+        {
+            ema=alpha_*in[i]+(1-alpha_)*ema;
+            out[i]=ema;
+        }
+    }
 };
 }
\ No newline at end of file
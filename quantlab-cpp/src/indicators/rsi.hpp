@@ -1,6 +1,10 @@
 #pragma once
 
 #include "rolling_ema.hpp"
+#include "../core/simd.hpp"
+#include <span>
+#include <vector>
+#include <cassert>
 
 namespace quantlab::indicators {
 
@@ -75,6 +79,85 @@ public:
         // Check if RSI has enough data
         return initialized_;
     }
+    
+    // Snapshot for incremental runs: both smoothing EMAs plus the last price seen
+    void save_state(quantlab::core::StateWriter& out) const {
+        gains_ema_.save_state(out);
+        losses_ema_.save_state(out);
+        out.write(previous_price_);
+        out.write(current_rsi_);
+        out.write_bool(initialized_);
+    }
+    
+    // Restores on success only; on a malformed or mismatched snapshot the RSI is unchanged
+    bool load_state(quantlab::core::StateReader& in) {
+        RSI restored = *this;
+        if (!restored.gains_ema_.load_state(in) || !restored.losses_ema_.load_state(in) ||
+            !in.read(restored.previous_price_) || !in.read(restored.current_rsi_) ||
+            !in.read_bool(restored.initialized_)) {
+            return false;
+        }
+        *this = restored;
+        return true;
+    }
+    
+    // Batch mode: RSI of a whole series, as if update() were called on a freshly reset indicator.
+    // Results are bit-identical to the streaming path: the vector steps use the same IEEE
+    // operations per element, and the serial EMA smoothing is RollingEMA::compute.
+    void compute(std::span<const double> in, std::span<double> out) const {
+        namespace simd = quantlab::core::simd;
+        assert(out.size() >= in.size());
+        const size_t n = in.size();
+        if (n == 0) return;
+        out[0] = 50.0;  // First price only seeds previous_price_, RSI is neutral
+        if (n == 1) return;
+        
+        // STEP 1 (SIMD): split price changes into gains and losses
+        // out[1..] holds gains, losses[1..] holds losses
+        double* gains = out.data();
+        std::vector<double> losses(n);
+        const simd::VecD zero = simd::set1(0.0);
+        size_t i = 1;
+        for (; i + simd::WIDTH <= n; i += simd::WIDTH) {
+            simd::VecD change = simd::sub(simd::load(&in[i]), simd::load(&in[i - 1]));
+            simd::store(&gains[i], simd::max(change, zero));
+            simd::store(&losses[i], simd::max(simd::sub(zero, change), zero));
+        }
+        for (; i < n; ++i) {
+            double change = in[i] - in[i - 1];
+            gains[i] = (change > 0) ? change : 0.0;
+            losses[i] = (change < 0) ? -change : 0.0;
+        }
+        
+        // STEP 2 (serial): EMA smoothing of gains and losses, in place
+        std::span<double> gain_series(gains + 1, n - 1);
+        std::span<double> loss_series(losses.data() + 1, n - 1);
+        gains_ema_.compute(gain_series, gain_series);
+        losses_ema_.compute(loss_series, loss_series);
+        
+        // STEP 3 (SIMD): RS and RSI with the same zero guards as update()
+        const simd::VecD hundred = simd::set1(100.0);
+        const simd::VecD fifty = simd::set1(50.0);
+        const simd::VecD one = simd::set1(1.0);
+        i = 1;
+        for (; i + simd::WIDTH <= n; i += simd::WIDTH) {
+            simd::VecD avg_gain = simd::load(&gains[i]);
+            simd::VecD avg_loss = simd::load(&losses[i]);
+            simd::VecD rs = simd::div(avg_gain, avg_loss);
+            simd::VecD rsi = simd::sub(hundred, simd::div(hundred, simd::add(one, rs)));
+            simd::MaskD no_loss = simd::cmp_eq(avg_loss, zero);
+            rsi = simd::select(no_loss, hundred, rsi);
+            rsi = simd::select(simd::mask_and(no_loss, simd::cmp_eq(avg_gain, zero)), fifty, rsi);
+            simd::store(&out[i], rsi);
+        }
+        for (; i < n; ++i) {
+            double avg_gain = gains[i];
+            double avg_loss = losses[i];
+            if (avg_loss == 0.0 && avg_gain == 0.0) out[i] = 50.0;
+            else if (avg_loss == 0.0) out[i] = 100.0;
+            else out[i] = 100.0 - (100. / (1.0 + avg_gain / avg_loss));
+        }
+    }
 };
 
 } // namespace quantlab::indicators
\ No newline at end of file
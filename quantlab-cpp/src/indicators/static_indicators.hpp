@@ -0,0 +1,146 @@
+#pragma once
+
+#include "bollinger_bands.hpp"
+#include <array>
+#include <span>
+#include <cmath>
+#include <cstddef>
+
+namespace quantlab::indicators {
+
+/**
+ * Compile-time configured EMA / RSI / Bollinger Bands
+ *
+ * Same recurrences as RollingEMA, RSI and BollingerBands, but the period
+ * (and Bollinger multiplier) are template arguments: alpha is a constant,
+ * the Bollinger window is a std::array inside the object (no heap), and
+ * divisions by the period become multiplications by its reciprocal.
+ * StaticEMA is bit-identical to RollingEMA; RSI and the bands can differ
+ * from the runtime classes in the last bit (reciprocal multiply, RSI with
+ * one division instead of two).
+ *
+ * Used by StaticMeanReversionStrategy; the runtime classes remain the
+ * general-purpose ones (state snapshots, batch compute, IndicatorBank).
+ */
+template<int Period>
+class StaticEMA {
+    static_assert(Period > 0, "EMA period must be positive");
+
+public:
+    static constexpr double ALPHA = 2.0 / (Period + 1);  // Same value RollingEMA computes
+
+    double update(double price) {
+        if (!initialized_) {
+            ema_ = price;  // First price becomes initial EMA
+            initialized_ = true;
+        } else {
+            ema_ = ALPHA * price + (1 - ALPHA) * ema_;
+        }
+        return ema_;
+    }
+
+    double value() const { return ema_; }
+    bool is_initialized() const { return initialized_; }
+
+    void reset() {
+        ema_ = 0.0;
+        initialized_ = false;
+    }
+
+private:
+    double ema_ = 0.0;
+    bool initialized_ = false;
+};
+
+template<int Period>
+class StaticRSI {
+public:
+    double update(double price) {
+        if (!initialized_) {
+            previous_price_ = price;  // First price only seeds the change, RSI stays neutral
+            initialized_ = true;
+            return rsi_;
+        }
+        double change = price - previous_price_;
+        double avg_gain = gains_.update(change > 0 ? change : 0.0);
+        double avg_loss = losses_.update(change < 0 ? -change : 0.0);
+        if (avg_loss == 0.0 && avg_gain == 0.0) rsi_ = 50.0;
+        else if (avg_loss == 0.0) rsi_ = 100.0;
+        else rsi_ = 100.0 * avg_gain / (avg_gain + avg_loss);  // = 100 - 100 / (1 + RS), one division
+        previous_price_ = price;
+        return rsi_;
+    }
+
+    double value() const { return rsi_; }
+    bool is_initialized() const { return initialized_; }
+
+    void reset() {
+        gains_.reset();
+        losses_.reset();
+        previous_price_ = 0.0;
+        rsi_ = 50.0;
+        initialized_ = false;
+    }
+
+private:
+    StaticEMA<Period> gains_;
+    StaticEMA<Period> losses_;
+    double previous_price_ = 0.0;
+    double rsi_ = 50.0;
+    bool initialized_ = false;
+};
+
+// Sliding Welford window with BollingerBands' renormalization schedule (once per revolution)
+template<int Period, double StdDevMultiplier>
+class StaticBollingerBands {
+    static_assert(Period > 0, "Bollinger period must be positive");
+    static constexpr size_t N = static_cast<size_t>(Period);
+    static constexpr double INV_N = 1.0 / Period;
+
+public:
+    BollingerBandsResult update(double price) {
+        if (count_ < N) {
+            window_[head_] = price;
+            head_ = head_ + 1 == N ? 0 : head_ + 1;
+            ++count_;
+            BollingerBands::welford_insert(mean_, m2_, price, count_);
+            if (count_ < N) return BollingerBandsResult{0.0, 0.0, 0.0};  // Not enough data yet
+        } else {
+            double oldest = window_[head_];
+            window_[head_] = price;
+            head_ = head_ + 1 == N ? 0 : head_ + 1;
+            // BollingerBands::welford_slide with the division by N as a multiply
+            double old_mean = mean_;
+            double delta = price - oldest;
+            mean_ += delta * INV_N;
+            m2_ += delta * (price - mean_ + oldest - old_mean);
+            if (head_ == 0) {
+                BollingerBands::exact_stats(mean_, m2_, std::span<const double>(window_));
+            }
+        }
+        double std_dev = std::sqrt(m2_ > 0.0 ? m2_ * INV_N : 0.0);
+        bands_ = {mean_ + StdDevMultiplier * std_dev, mean_, mean_ - StdDevMultiplier * std_dev};
+        return bands_;
+    }
+
+    const BollingerBandsResult& value() const { return bands_; }
+    bool is_initialized() const { return count_ == N; }
+
+    void reset() {
+        head_ = 0;
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        bands_ = {0.0, 0.0, 0.0};
+    }
+
+private:
+    std::array<double, N> window_{};
+    size_t head_ = 0;
+    size_t count_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    BollingerBandsResult bands_{0.0, 0.0, 0.0};
+};
+
+} // namespace quantlab::indicators
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <cstddef>
+
+namespace quantlab::optimization {
+
+/**
+ * Parameter set for strategy optimization
+ */
+struct ParameterSet {
+    std::string symbol;
+    int days;
+    double confidence_threshold;
+    int ema_period;
+    int rsi_period;
+    int bb_period;
+    int rsi_oversold;
+    int rsi_overbought;
+
+    ParameterSet(const std::string& sym, int d, double conf, int ema = 20, int rsi = 14, int bb = 20,
+                 int oversold = 30, int overbought = 70)
+        : symbol(sym), days(d), confidence_threshold(conf), ema_period(ema), rsi_period(rsi), bb_period(bb),
+          rsi_oversold(oversold), rsi_overbought(overbought) {}
+};
+
+// Identity of a parameter set, for de-duplication and lookups
+inline auto parameter_key(const ParameterSet& p) {
+    return std::make_tuple(p.symbol, p.days, p.confidence_threshold, p.ema_period, p.rsi_period,
+                           p.bb_period, p.rsi_oversold, p.rsi_overbought);
+}
+
+/**
+ * Optimization result for a single parameter set
+ */
+struct OptimizationResult {
+    ParameterSet parameters;
+    double total_return;
+    double max_drawdown;
+    double sharpe_ratio;
+    int total_trades;
+    int winning_trades;
+    double win_rate;
+    double profit_factor;
+    bool pruned;              // Stopped early by the pruning policy (metrics as of that bar)
+    size_t bars_evaluated;    // Backtested bars actually run
+    bool failed;              // The backtest threw (e.g. a fetch error); metrics are placeholders
+
+    OptimizationResult(const ParameterSet& params)
+        : parameters(params), total_return(0.0), max_drawdown(0.0),
+          sharpe_ratio(0.0), total_trades(0), winning_trades(0),
+          win_rate(0.0), profit_factor(0.0), pruned(false), bars_evaluated(0), failed(false) {}
+};
+
+} // namespace quantlab::optimization
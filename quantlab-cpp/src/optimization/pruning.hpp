@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "../backtest/backtest_engine.hpp"
+
+namespace quantlab::optimization {
+
+/**
+ * How far a configuration has got through its backtest window
+ */
+struct TrialProgress {
+    size_t bars_done;     // Backtested bars so far (warm-up excluded)
+    size_t bars_total;    // Backtested bars in the whole window
+};
+
+/**
+ * Early-termination hook for optimizer sweeps
+ *
+ * The optimizer advances every configuration of a data window together, bar
+ * by bar, and consults the policy after each bar:
+ *
+ *   should_prune()  per configuration, on its running metrics - stop it now
+ *   survivors()     for the cohort still running - how many of them to keep
+ *                   (the best by score(), ties kept in grid order)
+ *
+ * Pruned configurations report the metrics they had when they were stopped.
+ * The defaults prune nothing.
+ */
+class PruningPolicy {
+public:
+    virtual ~PruningPolicy() = default;
+
+    virtual bool should_prune(const quantlab::backtest::BacktestMetrics& /*metrics*/,
+                              const TrialProgress& /*progress*/) const {
+        return false;
+    }
+
+    virtual size_t survivors(size_t alive, const TrialProgress& /*progress*/) const { return alive; }
+
+    // Ranking used by survivors(): higher is better
+    virtual double score(const quantlab::backtest::BacktestMetrics& metrics) const {
+        return metrics.total_return_pct;
+    }
+};
+
+/**
+ * Drawdown / inactivity cutoffs plus optional successive halving
+ *
+ * - max_drawdown_pct: stop once the running drawdown exceeds it (0 = off)
+ * - min_trades: stop configurations with fewer trades than this once
+ *   min_trades_after of the window has passed (0 = off)
+ * - halving_rungs: fractions of the window (e.g. {0.25, 0.5}) at which the
+ *   cohort is ranked by return and only the top 1/eta is kept running
+ *
+ * All defaults off, so a default-constructed policy prunes nothing.
+ */
+class SimplePruningPolicy : public PruningPolicy {
+private:
+    double max_drawdown_pct_;
+    int min_trades_;
+    double min_trades_after_;
+    std::vector<double> halving_rungs_;
+    double eta_;
+
+    // Bar count at which a window fraction is reached
+    static size_t bar_at(double fraction, size_t bars_total) {
+        return static_cast<size_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * bars_total));
+    }
+
+public:
+    explicit SimplePruningPolicy(double max_drawdown_pct = 0.0, int min_trades = 0, double min_trades_after = 0.5,
+                                 std::vector<double> halving_rungs = {}, double eta = 2.0)
+        : max_drawdown_pct_(max_drawdown_pct), min_trades_(min_trades), min_trades_after_(min_trades_after),
+          halving_rungs_(std::move(halving_rungs)), eta_(std::max(eta, 1.0)) {}
+
+    bool should_prune(const quantlab::backtest::BacktestMetrics& metrics,
+                      const TrialProgress& progress) const override {
+        if (max_drawdown_pct_ > 0.0 && metrics.max_drawdown_pct > max_drawdown_pct_) return true;
+        if (min_trades_ > 0 && metrics.total_trades < min_trades_ &&
+            progress.bars_done >= bar_at(min_trades_after_, progress.bars_total)) {
+            return true;
+        }
+        return false;
+    }
+
+    size_t survivors(size_t alive, const TrialProgress& progress) const override {
+        for (double rung : halving_rungs_) {
+            if (progress.bars_done == bar_at(rung, progress.bars_total) && progress.bars_done < progress.bars_total) {
+                return std::max<size_t>(1, static_cast<size_t>(std::ceil(alive / eta_)));
+            }
+        }
+        return alive;
+    }
+};
+
+/**
+ * Apply a policy to the lanes still running after a bar
+ *
+ * Per-lane cutoffs first, then the cohort cut (best scores survive, ties in
+ * grid order); `alive` stays in grid order. Lane is any struct with an
+ * `engine` (BacktestEngine), `pruned` and `stop_price`: every lane stopped
+ * here records `price`, the close of the bar it stopped on, so it can be
+ * finalized at a price it actually traded at.
+ */
+template<typename Lane>
+void prune_lanes(const PruningPolicy& policy, std::vector<Lane>& lanes, std::vector<size_t>& alive,
+                 const TrialProgress& progress, double price) {
+    auto stop = [&](Lane& lane) {
+        lane.pruned = true;
+        lane.stop_price = price;
+    };
+    
+    std::erase_if(alive, [&](size_t l) {
+        if (!policy.should_prune(lanes[l].engine.current_metrics(), progress)) return false;
+        stop(lanes[l]);
+        return true;
+    });
+    
+    size_t keep = policy.survivors(alive.size(), progress);
+    if (keep >= alive.size()) return;
+    
+    std::vector<double> scores(lanes.size(), 0.0);
+    for (size_t l : alive) scores[l] = policy.score(lanes[l].engine.current_metrics());
+    std::stable_sort(alive.begin(), alive.end(), [&](size_t a, size_t b) { return scores[a] > scores[b]; });
+    for (size_t i = keep; i < alive.size(); ++i) stop(lanes[alive[i]]);
+    alive.resize(keep);
+    std::sort(alive.begin(), alive.end());
+}
+
+} // namespace quantlab::optimization
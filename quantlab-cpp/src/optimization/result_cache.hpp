@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <iostream>
+#include "optimization_types.hpp"
+#include "../core/data_types.hpp"
+#include "../core/state_io.hpp"
+#include "../backtest/backtest_engine.hpp"
+
+namespace quantlab::optimization {
+
+/**
+ * Which bars a result was computed on
+ *
+ * A backtest window only ever grows at its end, so the last bar's timestamp
+ * plus the bar count identify its contents; a new bar (or a revised history)
+ * changes the version.
+ */
+struct DataVersion {
+    int64_t last_timestamp_ns = 0;
+    uint64_t bars = 0;
+
+    bool operator==(const DataVersion&) const = default;
+
+    static DataVersion of(const quantlab::core::BarColumnsView& bars) {
+        return {bars.empty() ? 0 : bars.timestamp_ns.back(), bars.size()};
+    }
+};
+
+// Content address of a parameter set: FNV-1a over its fields
+inline uint64_t parameter_hash(const ParameterSet& p) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(p.symbol.data(), p.symbol.size());
+    const int32_t fields[] = {p.days, p.ema_period, p.rsi_period, p.bb_period, p.rsi_oversold, p.rsi_overbought};
+    mix(fields, sizeof(fields));
+    mix(&p.confidence_threshold, sizeof(p.confidence_threshold));
+    return hash;
+}
+
+/**
+ * Memoized backtest results, safe to share between optimizers on different threads
+ *
+ * Entries are addressed by parameter_hash() and remember the DataVersion they
+ * were computed on. A lookup against newer data misses, and the fresh result
+ * replaces the stale one, so each parameter set holds at most one entry and
+ * results are invalidated exactly when new bars arrive.
+ *
+ * Only complete backtests belong here: a pruned result depends on the
+ * pruning policy, not just on the parameters and the data, and a failed one
+ * (e.g. a transient fetch error) must be retried, not replayed.
+ *
+ * load() / save() persist the cache (format QLRCACHE v2, see save()). A file
+ * written under another BacktestEngine::RESULTS_VERSION is discarded whole.
+ */
+class ResultCache {
+private:
+    static constexpr char MAGIC[8] = {'Q', 'L', 'R', 'C', 'A', 'C', 'H', 'E'};
+    static constexpr uint32_t VERSION = 2;
+
+    struct Entry {
+        DataVersion version;
+        OptimizationResult result;
+    };
+
+    std::unordered_map<uint64_t, Entry> entries_;
+    mutable std::mutex mutex_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+
+public:
+    std::optional<OptimizationResult> find(const ParameterSet& params, const DataVersion& version) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(parameter_hash(params));
+            if (it != entries_.end() && it->second.version == version &&
+                parameter_key(it->second.result.parameters) == parameter_key(params)) {
+                ++hits_;
+                return it->second.result;
+            }
+        }
+        ++misses_;
+        return std::nullopt;
+    }
+
+    void insert(const OptimizationResult& result, const DataVersion& version) {
+        if (result.pruned || result.failed) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.insert_or_assign(parameter_hash(result.parameters), Entry{version, result});
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+    // "QLRCACHE" | u32 version | u32 results version | u64 count | count x (parameters, data version, metrics)
+    bool save(const std::string& path) const {
+        quantlab::core::StateWriter out;
+        out.write(MAGIC);
+        out.write<uint32_t>(VERSION);
+        out.write<uint32_t>(quantlab::backtest::BacktestEngine::RESULTS_VERSION);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            out.write<uint64_t>(entries_.size());
+            for (const auto& [hash, entry] : entries_) {
+                const auto& r = entry.result;
+                const auto& p = r.parameters;
+                out.write_string(p.symbol);
+                out.write<int32_t>(p.days);
+                out.write(p.confidence_threshold);
+                out.write<int32_t>(p.ema_period);
+                out.write<int32_t>(p.rsi_period);
+                out.write<int32_t>(p.bb_period);
+                out.write<int32_t>(p.rsi_oversold);
+                out.write<int32_t>(p.rsi_overbought);
+                out.write(entry.version.last_timestamp_ns);
+                out.write(entry.version.bars);
+                out.write(r.total_return);
+                out.write(r.max_drawdown);
+                out.write(r.sharpe_ratio);
+                out.write<int32_t>(r.total_trades);
+                out.write<int32_t>(r.winning_trades);
+                out.write(r.win_rate);
+                out.write(r.profit_factor);
+                out.write<uint64_t>(r.bars_evaluated);
+            }
+        }
+        return quantlab::core::write_state_file(path, out.buffer());
+    }
+
+    // Merge a saved cache into this one; false (cache unchanged) if the file is missing or unusable
+    bool load(const std::string& path) {
+        auto blob = quantlab::core::read_state_file(path);
+        if (!blob.has_value()) return false;
+
+        quantlab::core::StateReader in(*blob);
+        char magic[sizeof(MAGIC)] = {};
+        uint32_t version = 0, results_version = 0;
+        uint64_t count = 0;
+        if (!in.read(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !in.read(version) ||
+            version != VERSION || !in.read(results_version) || !in.read(count)) {
+            std::cerr << "⚠️  Ignoring incompatible result cache " << path << std::endl;
+            return false;
+        }
+        if (results_version != quantlab::backtest::BacktestEngine::RESULTS_VERSION) {
+            std::cerr << "⚠️  Ignoring result cache " << path << " from another backtest engine version ("
+                      << results_version << ", now " << quantlab::backtest::BacktestEngine::RESULTS_VERSION << ")"
+                      << std::endl;
+            return false;
+        }
+
+        std::vector<Entry> loaded;
+        for (uint64_t i = 0; i < count; ++i) {
+            std::string symbol;
+            int32_t days = 0, ema = 0, rsi = 0, bb = 0, oversold = 0, overbought = 0, trades = 0, wins = 0;
+            double confidence = 0.0;
+            DataVersion data;
+            OptimizationResult r(ParameterSet("", 0, 0.0));
+            uint64_t bars_evaluated = 0;
+            if (!in.read_string(symbol) || !in.read(days) || !in.read(confidence) || !in.read(ema) ||
+                !in.read(rsi) || !in.read(bb) || !in.read(oversold) || !in.read(overbought) ||
+                !in.read(data.last_timestamp_ns) || !in.read(data.bars) || !in.read(r.total_return) ||
+                !in.read(r.max_drawdown) || !in.read(r.sharpe_ratio) || !in.read(trades) || !in.read(wins) ||
+                !in.read(r.win_rate) || !in.read(r.profit_factor) || !in.read(bars_evaluated)) {
+                std::cerr << "⚠️  Ignoring truncated result cache " << path << std::endl;
+                return false;
+            }
+            r.parameters = ParameterSet(symbol, days, confidence, ema, rsi, bb, oversold, overbought);
+            r.total_trades = trades;
+            r.winning_trades = wins;
+            r.bars_evaluated = static_cast<size_t>(bars_evaluated);
+            loaded.push_back({data, std::move(r)});
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : loaded) {
+            uint64_t hash = parameter_hash(entry.result.parameters);
+            entries_.insert_or_assign(hash, std::move(entry));
+        }
+        return true;
+    }
+};
+
+} // namespace quantlab::optimization
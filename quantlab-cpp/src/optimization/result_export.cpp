@@ -0,0 +1,352 @@
+#include "result_export.hpp"
+#include "../core/profiler.hpp"
+#include <fmt/format.h>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <set>
+#include <map>
+
+namespace quantlab::optimization {
+
+namespace {
+
+constexpr char RESULT_MAGIC[8] = {'Q', 'L', 'R', 'E', 'S', 'L', 'T', '\0'};
+
+// Flush the text buffer once it grows past this, so huge sweeps do not hold the whole file in memory
+constexpr size_t FLUSH_BYTES = 1 << 20;
+
+void flush(std::ofstream& file, fmt::memory_buffer& buffer) {
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+bool finish(std::ofstream& file, fmt::memory_buffer& buffer, const std::string& filename) {
+    flush(file, buffer);
+    file.close();
+    if (!file) {
+        std::cerr << "❌ Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::ofstream> open_output(const std::string& filename, std::ios::openmode mode = std::ios::out) {
+    std::ofstream file(filename, mode | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "❌ Error: Could not open " << filename << " for writing" << std::endl;
+        return std::nullopt;
+    }
+    return file;
+}
+
+// Columnar file assembled in memory: headers first, then each column at an 8-byte aligned offset
+class ColumnWriter {
+private:
+    std::vector<ResultColumn> columns_;
+    std::vector<uint8_t> data_;
+
+public:
+    template<typename T>
+    void add(const char* name, ResultColumnType type, std::span<const T> values) {
+        add_bytes(name, type, reinterpret_cast<const uint8_t*>(values.data()), values.size_bytes());
+    }
+
+    void add_bytes(const char* name, ResultColumnType type, const uint8_t* bytes, size_t size) {
+        ResultColumn column{};
+        std::strncpy(column.name, name, RESULT_COLUMN_NAME_SIZE - 1);
+        column.type = type;
+        column.offset = data_.size();  // Relative to the data section until write()
+        column.bytes = size;
+        columns_.push_back(column);
+        data_.insert(data_.end(), bytes, bytes + size);
+        data_.resize((data_.size() + 7) & ~size_t{7}, 0);
+    }
+
+    bool write(const std::string& filename, uint64_t rows) {
+        ResultFileHeader header{};
+        std::memcpy(header.magic, RESULT_MAGIC, sizeof(RESULT_MAGIC));
+        header.version = RESULT_FILE_VERSION;
+        header.column_count = static_cast<uint32_t>(columns_.size());
+        header.row_count = rows;
+
+        const uint64_t data_start = sizeof(ResultFileHeader) + columns_.size() * sizeof(ResultColumn);  // 24 + 56n: 8-aligned
+        for (auto& column : columns_) column.offset += data_start;
+
+        auto file = open_output(filename, std::ios::binary);
+        if (!file) return false;
+        file->write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file->write(reinterpret_cast<const char*>(columns_.data()), columns_.size() * sizeof(ResultColumn));
+        file->write(reinterpret_cast<const char*>(data_.data()), data_.size());
+        file->close();
+        if (!*file) {
+            std::cerr << "❌ Error: Failed writing " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+template<typename T, typename Field>
+std::vector<T> gather(std::span<const OptimizationResult> results, Field field) {
+    std::vector<T> column;
+    column.reserve(results.size());
+    for (const auto& result : results) column.push_back(static_cast<T>(field(result)));
+    return column;
+}
+
+// Column lookup over a loaded file, checked against the row count
+class ColumnReader {
+private:
+    std::span<const uint8_t> file_;
+    std::span<const ResultColumn> columns_;
+    uint64_t rows_;
+
+public:
+    ColumnReader(std::span<const uint8_t> file, std::span<const ResultColumn> columns, uint64_t rows)
+        : file_(file), columns_(columns), rows_(rows) {}
+
+    const ResultColumn* find(const char* name, ResultColumnType type) const {
+        for (const auto& column : columns_) {
+            if (std::strncmp(column.name, name, RESULT_COLUMN_NAME_SIZE) == 0 && column.type == type &&
+                column.offset <= file_.size() && column.bytes <= file_.size() - column.offset) {
+                return &column;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    bool get(const char* name, ResultColumnType type, std::vector<T>& out) const {
+        const ResultColumn* column = find(name, type);
+        if (!column || column->bytes != rows_ * sizeof(T)) {
+            std::cerr << "❌ Error: Result file is missing column '" << name << "'" << std::endl;
+            return false;
+        }
+        out.resize(static_cast<size_t>(rows_));
+        std::memcpy(out.data(), file_.data() + column->offset, column->bytes);
+        return true;
+    }
+
+    bool strings(const char* name, std::vector<std::string>& out) const {
+        const ResultColumn* column = find(name, ResultColumnType::STRINGS);
+        if (!column) {
+            std::cerr << "❌ Error: Result file is missing column '" << name << "'" << std::endl;
+            return false;
+        }
+        const char* begin = reinterpret_cast<const char*>(file_.data() + column->offset);
+        const char* end = begin + column->bytes;
+        while (begin < end) {
+            const char* nul = static_cast<const char*>(std::memchr(begin, '\0', end - begin));
+            if (!nul) return false;
+            out.emplace_back(begin, nul);
+            begin = nul + 1;
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool write_results_csv(const std::string& filename, std::span<const OptimizationResult> results) {
+    QUANTLAB_PROFILE_SCOPE(EXPORT);
+    QUANTLAB_PROFILE_COUNT(ROWS_EXPORTED, results.size());
+    auto file = open_output(filename);
+    if (!file) return false;
+
+    fmt::memory_buffer buffer;
+    auto out = std::back_inserter(buffer);
+    fmt::format_to(out, "Symbol,Days,Confidence_Threshold,Total_Return,Max_Drawdown,Sharpe_Ratio,"
+                        "Total_Trades,Winning_Trades,Win_Rate,Profit_Factor,EMA_Period,RSI_Period,BB_Period,"
+                        "Pruned,Bars_Evaluated,RSI_Oversold,RSI_Overbought,Failed\n");
+
+    for (const auto& result : results) {
+        const auto& p = result.parameters;
+        fmt::format_to(out, "{},{},{:.3f},{:.4f},{:.4f},{:.4f},{},{},{:.2f},{:.2f},{},{},{},{},{},{},{},{}\n",
+                       p.symbol, p.days, p.confidence_threshold, result.total_return, result.max_drawdown,
+                       result.sharpe_ratio, result.total_trades, result.winning_trades, result.win_rate,
+                       result.profit_factor, p.ema_period, p.rsi_period, p.bb_period, result.pruned ? 1 : 0,
+                       result.bars_evaluated, p.rsi_oversold, p.rsi_overbought, result.failed ? 1 : 0);
+        if (buffer.size() >= FLUSH_BYTES) flush(*file, buffer);
+    }
+    return finish(*file, buffer, filename);
+}
+
+bool write_results_json(const std::string& filename, std::span<const OptimizationResult> results) {
+    QUANTLAB_PROFILE_SCOPE(EXPORT);
+    QUANTLAB_PROFILE_COUNT(ROWS_EXPORTED, results.size());
+    auto file = open_output(filename);
+    if (!file) return false;
+
+    fmt::memory_buffer buffer;
+    auto out = std::back_inserter(buffer);
+    fmt::format_to(out, "{{\n  \"optimization_results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        const auto& p = result.parameters;
+        fmt::format_to(out,
+                       "    {{\n"
+                       "      \"symbol\": \"{}\",\n"
+                       "      \"days\": {},\n"
+                       "      \"confidence_threshold\": {:.3f},\n"
+                       "      \"ema_period\": {},\n"
+                       "      \"rsi_period\": {},\n"
+                       "      \"bb_period\": {},\n"
+                       "      \"rsi_oversold\": {},\n"
+                       "      \"rsi_overbought\": {},\n"
+                       "      \"total_return\": {:.4f},\n"
+                       "      \"total_return_pct\": {:.2f},\n"
+                       "      \"max_drawdown\": {:.4f},\n"
+                       "      \"sharpe_ratio\": {:.4f},\n"
+                       "      \"total_trades\": {},\n"
+                       "      \"winning_trades\": {},\n"
+                       "      \"win_rate\": {:.2f},\n"
+                       "      \"profit_factor\": {:.2f},\n"
+                       "      \"pruned\": {},\n"
+                       "      \"bars_evaluated\": {},\n"
+                       "      \"failed\": {}\n"
+                       "    }}{}\n",
+                       p.symbol, p.days, p.confidence_threshold, p.ema_period, p.rsi_period, p.bb_period,
+                       p.rsi_oversold, p.rsi_overbought, result.total_return, result.total_return * 100,
+                       result.max_drawdown, result.sharpe_ratio, result.total_trades, result.winning_trades,
+                       result.win_rate, result.profit_factor, result.pruned, result.bars_evaluated,
+                       result.failed, i + 1 < results.size() ? "," : "");
+        if (buffer.size() >= FLUSH_BYTES) flush(*file, buffer);
+    }
+
+    std::set<std::string> unique_symbols;
+    for (const auto& result : results) unique_symbols.insert(result.parameters.symbol);
+
+    fmt::format_to(out, "  ],\n  \"summary\": {{\n    \"total_combinations\": {},\n    \"symbols_tested\": [",
+                   results.size());
+    bool first = true;
+    for (const auto& symbol : unique_symbols) {
+        fmt::format_to(out, "{}\"{}\"", first ? "" : ", ", symbol);
+        first = false;
+    }
+    fmt::format_to(out, "],\n    \"date_generated\": \"{}\"\n  }}\n}}\n", __DATE__);
+    return finish(*file, buffer, filename);
+}
+
+bool write_results_binary(const std::string& filename, std::span<const OptimizationResult> results) {
+    QUANTLAB_PROFILE_SCOPE(EXPORT);
+    QUANTLAB_PROFILE_COUNT(ROWS_EXPORTED, results.size());
+    // Symbol dictionary in first-seen order
+    std::map<std::string, uint32_t> symbol_ids;
+    std::vector<uint8_t> names;
+    std::vector<uint32_t> symbol_column;
+    symbol_column.reserve(results.size());
+    for (const auto& result : results) {
+        auto [it, inserted] = symbol_ids.emplace(result.parameters.symbol, static_cast<uint32_t>(symbol_ids.size()));
+        if (inserted) {
+            names.insert(names.end(), it->first.begin(), it->first.end());
+            names.push_back('\0');
+        }
+        symbol_column.push_back(it->second);
+    }
+
+    using T = ResultColumnType;
+    ColumnWriter writer;
+    writer.add_bytes("symbol_names", T::STRINGS, names.data(), names.size());
+    writer.add<uint32_t>("symbol", T::DICT32, symbol_column);
+
+    auto i32 = [&](const char* name, auto field) {
+        writer.add<int32_t>(name, T::I32, gather<int32_t>(results, field));
+    };
+    auto f64 = [&](const char* name, auto field) {
+        writer.add<double>(name, T::F64, gather<double>(results, field));
+    };
+    i32("days", [](const OptimizationResult& r) { return r.parameters.days; });
+    f64("confidence_threshold", [](const OptimizationResult& r) { return r.parameters.confidence_threshold; });
+    i32("ema_period", [](const OptimizationResult& r) { return r.parameters.ema_period; });
+    i32("rsi_period", [](const OptimizationResult& r) { return r.parameters.rsi_period; });
+    i32("bb_period", [](const OptimizationResult& r) { return r.parameters.bb_period; });
+    i32("rsi_oversold", [](const OptimizationResult& r) { return r.parameters.rsi_oversold; });
+    i32("rsi_overbought", [](const OptimizationResult& r) { return r.parameters.rsi_overbought; });
+    f64("total_return", [](const OptimizationResult& r) { return r.total_return; });
+    f64("max_drawdown", [](const OptimizationResult& r) { return r.max_drawdown; });
+    f64("sharpe_ratio", [](const OptimizationResult& r) { return r.sharpe_ratio; });
+    i32("total_trades", [](const OptimizationResult& r) { return r.total_trades; });
+    i32("winning_trades", [](const OptimizationResult& r) { return r.winning_trades; });
+    f64("win_rate", [](const OptimizationResult& r) { return r.win_rate; });
+    f64("profit_factor", [](const OptimizationResult& r) { return r.profit_factor; });
+    writer.add<uint8_t>("pruned", T::U8, gather<uint8_t>(results, [](const OptimizationResult& r) { return r.pruned; }));
+    writer.add<uint64_t>("bars_evaluated", T::U64,
+                         gather<uint64_t>(results, [](const OptimizationResult& r) { return r.bars_evaluated; }));
+    writer.add<uint8_t>("failed", T::U8, gather<uint8_t>(results, [](const OptimizationResult& r) { return r.failed; }));
+
+    return writer.write(filename, results.size());
+}
+
+std::optional<std::vector<OptimizationResult>> read_results_binary(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "❌ Error: Could not open " << filename << std::endl;
+        return std::nullopt;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ResultFileHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        std::cerr << "❌ Error: " << filename << " is not a result file" << std::endl;
+        return std::nullopt;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, RESULT_MAGIC, sizeof(RESULT_MAGIC)) != 0 || header.version != RESULT_FILE_VERSION ||
+        header.column_count > (bytes.size() - sizeof(header)) / sizeof(ResultColumn)) {
+        std::cerr << "❌ Error: " << filename << " is not a version " << RESULT_FILE_VERSION << " result file" << std::endl;
+        return std::nullopt;
+    }
+    std::vector<ResultColumn> columns(header.column_count);
+    std::memcpy(columns.data(), bytes.data() + sizeof(header), columns.size() * sizeof(ResultColumn));
+
+    using T = ResultColumnType;
+    ColumnReader reader(bytes, columns, header.row_count);
+    std::vector<std::string> names;
+    std::vector<uint32_t> symbol;
+    std::vector<int32_t> days, ema, rsi, bb, oversold, overbought, trades, wins;
+    std::vector<double> confidence, total_return, drawdown, sharpe, win_rate, profit_factor;
+    std::vector<uint8_t> pruned;
+    std::vector<uint64_t> bars;
+    bool ok = reader.strings("symbol_names", names) && reader.get("symbol", T::DICT32, symbol) &&
+              reader.get("days", T::I32, days) && reader.get("confidence_threshold", T::F64, confidence) &&
+              reader.get("ema_period", T::I32, ema) && reader.get("rsi_period", T::I32, rsi) &&
+              reader.get("bb_period", T::I32, bb) && reader.get("rsi_oversold", T::I32, oversold) &&
+              reader.get("rsi_overbought", T::I32, overbought) && reader.get("total_return", T::F64, total_return) &&
+              reader.get("max_drawdown", T::F64, drawdown) && reader.get("sharpe_ratio", T::F64, sharpe) &&
+              reader.get("total_trades", T::I32, trades) && reader.get("winning_trades", T::I32, wins) &&
+              reader.get("win_rate", T::F64, win_rate) && reader.get("profit_factor", T::F64, profit_factor) &&
+              reader.get("pruned", T::U8, pruned) && reader.get("bars_evaluated", T::U64, bars);
+    if (!ok) return std::nullopt;
+    
+    // Appended after the first files were written: absent means nothing failed
+    std::vector<uint8_t> failed(static_cast<size_t>(header.row_count), 0);
+    if (reader.find("failed", T::U8) && !reader.get("failed", T::U8, failed)) return std::nullopt;
+
+    std::vector<OptimizationResult> results;
+    results.reserve(static_cast<size_t>(header.row_count));
+    for (size_t i = 0; i < header.row_count; ++i) {
+        if (symbol[i] >= names.size()) {
+            std::cerr << "❌ Error: " << filename << " has a symbol index out of range" << std::endl;
+            return std::nullopt;
+        }
+        OptimizationResult result(ParameterSet(names[symbol[i]], days[i], confidence[i], ema[i], rsi[i], bb[i],
+                                               oversold[i], overbought[i]));
+        result.total_return = total_return[i];
+        result.max_drawdown = drawdown[i];
+        result.sharpe_ratio = sharpe[i];
+        result.total_trades = trades[i];
+        result.winning_trades = wins[i];
+        result.win_rate = win_rate[i];
+        result.profit_factor = profit_factor[i];
+        result.pruned = pruned[i] != 0;
+        result.bars_evaluated = static_cast<size_t>(bars[i]);
+        result.failed = failed[i] != 0;
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+} // namespace quantlab::optimization
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <span>
+#include "optimization_types.hpp"
+
+namespace quantlab::optimization {
+
+/**
+ * Optimizer result export
+ *
+ * Text formats (CSV / JSON) are formatted with fmt into one buffer and
+ * written in large blocks. The binary format is columnar and meant for
+ * loading without parsing: every column is one contiguous, 8-byte aligned
+ * array that a reader can mmap / np.frombuffer in place.
+ *
+ * BINARY LAYOUT (.qlr, version 1, native little-endian):
+ *
+ *   ResultFileHeader   magic "QLRESLT\0" | u32 version | u32 column_count | u64 row_count
+ *   ResultColumn[n]    name (32 bytes, NUL padded) | u8 type | 7 reserved | u64 offset | u64 bytes
+ *   column data        at each column's offset (from file start, multiple of 8)
+ *
+ * Column types: F64 / I32 / U8 / U64 arrays of row_count values. Symbols are
+ * a DICT32 column (u32 index per row) plus a STRINGS column holding the
+ * dictionary as NUL-terminated names in index order.
+ *
+ * Columns (in file order): symbol_names, symbol, days, confidence_threshold,
+ * ema_period, rsi_period, bb_period, rsi_oversold, rsi_overbought,
+ * total_return, max_drawdown, sharpe_ratio, total_trades, winning_trades,
+ * win_rate, profit_factor, pruned, bars_evaluated, failed (1 = the backtest
+ * threw; its metrics are placeholders). Readers look columns up by name, so
+ * later versions may append columns; files without "failed" read as 0.
+ */
+
+enum class ResultColumnType : uint8_t {
+    F64 = 1,
+    I32 = 2,
+    U8 = 3,
+    U64 = 4,
+    DICT32 = 5,
+    STRINGS = 6
+};
+
+constexpr uint32_t RESULT_FILE_VERSION = 1;
+constexpr size_t RESULT_COLUMN_NAME_SIZE = 32;
+
+struct ResultFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t column_count;
+    uint64_t row_count;
+};
+
+struct ResultColumn {
+    char name[RESULT_COLUMN_NAME_SIZE];
+    ResultColumnType type;
+    uint8_t reserved[7];
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+static_assert(sizeof(ResultFileHeader) == 24 && sizeof(ResultColumn) == 56, "binary result layout is fixed");
+
+// Same columns and precision as the historical CSV export (Failed appended last)
+bool write_results_csv(const std::string& filename, std::span<const OptimizationResult> results);
+
+// "optimization_results" array plus a summary block (symbols tested, build date)
+bool write_results_json(const std::string& filename, std::span<const OptimizationResult> results);
+
+// Binary columnar file, layout above
+bool write_results_binary(const std::string& filename, std::span<const OptimizationResult> results);
+
+// Load a binary result file back; nullopt (with a message on stderr) if it is missing or malformed
+std::optional<std::vector<OptimizationResult>> read_results_binary(const std::string& filename);
+
+} // namespace quantlab::optimization
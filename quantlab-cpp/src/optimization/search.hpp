@@ -0,0 +1,422 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <set>
+#include <map>
+#include <cmath>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "optimization_types.hpp"
+
+namespace quantlab::optimization {
+
+/**
+ * Inclusive numeric range of one search dimension
+ */
+struct ParameterRange {
+    double min;
+    double max;
+};
+
+/**
+ * Where the search drivers may look
+ *
+ * Symbols and window lengths are categorical; everything else is a numeric
+ * range (integers for periods and RSI levels, confidence rounded to 0.001).
+ * Drivers work in the unit cube [0, 1]^DIMENSIONS and decode() turns a point
+ * into a ParameterSet, so one sampler serves every dimension. Both
+ * categorical lists must be non-empty: the constructor (and every search
+ * driver taking a space) throws std::invalid_argument otherwise.
+ */
+struct SearchSpace {
+    std::vector<std::string> symbols;
+    std::vector<int> days;
+    ParameterRange confidence{0.5, 0.8};
+    ParameterRange ema_period{10, 50};
+    ParameterRange rsi_period{7, 21};
+    ParameterRange bb_period{10, 40};
+    ParameterRange rsi_oversold{20, 40};
+    ParameterRange rsi_overbought{60, 80};
+
+    static constexpr size_t DIMENSIONS = 8;
+    using Point = std::array<double, DIMENSIONS>;
+
+    SearchSpace(std::vector<std::string> symbol_list, std::vector<int> day_list)
+        : symbols(std::move(symbol_list)), days(std::move(day_list)) {
+        validate();
+    }
+
+    void validate() const {
+        if (symbols.empty()) throw std::invalid_argument("SearchSpace needs at least one symbol");
+        if (days.empty()) throw std::invalid_argument("SearchSpace needs at least one days value");
+    }
+
+    ParameterSet decode(const Point& u) const {
+        return ParameterSet(pick(symbols, u[0]), pick(days, u[1]),
+                            std::round(scale(confidence, u[2]) * 1000.0) / 1000.0,
+                            integer(ema_period, u[3]), integer(rsi_period, u[4]), integer(bb_period, u[5]),
+                            integer(rsi_oversold, u[6]), integer(rsi_overbought, u[7]));
+    }
+
+    // Unit-cube coordinates of a parameter set (centre of its cell for categorical values)
+    Point encode(const ParameterSet& p) const {
+        return {index_of(symbols, p.symbol), index_of(days, p.days), unscale(confidence, p.confidence_threshold),
+                unscale(ema_period, p.ema_period), unscale(rsi_period, p.rsi_period),
+                unscale(bb_period, p.bb_period), unscale(rsi_oversold, p.rsi_oversold),
+                unscale(rsi_overbought, p.rsi_overbought)};
+    }
+
+private:
+    static double scale(const ParameterRange& r, double u) { return r.min + std::clamp(u, 0.0, 1.0) * (r.max - r.min); }
+    static int integer(const ParameterRange& r, double u) { return static_cast<int>(std::lround(scale(r, u))); }
+    static double unscale(const ParameterRange& r, double v) {
+        return r.max > r.min ? std::clamp((v - r.min) / (r.max - r.min), 0.0, 1.0) : 0.5;
+    }
+
+    template<typename T>
+    static T pick(const std::vector<T>& values, double u) {
+        size_t i = static_cast<size_t>(std::clamp(u, 0.0, 1.0) * values.size());
+        return values[std::min(i, values.size() - 1)];
+    }
+
+    template<typename T>
+    static double index_of(const std::vector<T>& values, const T& value) {
+        auto it = std::find(values.begin(), values.end(), value);
+        size_t i = it == values.end() ? 0 : static_cast<size_t>(it - values.begin());
+        return (i + 0.5) / values.size();
+    }
+};
+
+// What a search maximizes
+using Objective = std::function<double(const OptimizationResult&)>;
+
+inline double total_return_objective(const OptimizationResult& result) { return result.total_return; }
+
+/**
+ * Search driver interface
+ *
+ * The optimizer repeatedly asks for a batch of parameter sets, backtests them
+ * (in parallel, one data pass per symbol window) and hands the results back.
+ * A driver is finished when propose() returns an empty batch.
+ */
+class SearchDriver {
+public:
+    virtual ~SearchDriver() = default;
+
+    virtual const char* name() const = 0;
+
+    // Up to max_count new parameter sets to evaluate; empty once the search is done
+    virtual std::vector<ParameterSet> propose(size_t max_count) = 0;
+
+    // Results for previously proposed parameter sets (any order, any subset)
+    virtual void observe(const std::vector<OptimizationResult>& results) = 0;
+};
+
+/**
+ * Bookkeeping shared by the drivers below: evaluation budget, seeded RNG,
+ * de-duplication of decoded parameter sets and the scored history.
+ */
+class BudgetedSearch : public SearchDriver {
+protected:
+    using Key = decltype(parameter_key(std::declval<const ParameterSet&>()));
+
+    SearchSpace space_;
+    size_t budget_;
+    size_t proposed_ = 0;
+    Objective objective_;
+    std::mt19937_64 rng_;
+    std::set<Key> seen_;
+    std::map<Key, double> scores_;
+    std::vector<std::pair<SearchSpace::Point, double>> history_;  // Observed (point, score)
+
+    BudgetedSearch(SearchSpace space, size_t budget, uint64_t seed, Objective objective)
+        : space_(std::move(space)), budget_(budget),
+          objective_(objective ? std::move(objective) : Objective(total_return_objective)), rng_(seed) {
+        space_.validate();  // Fields are public: catch lists emptied after construction too
+    }
+
+    size_t remaining() const { return budget_ - proposed_; }
+
+    double uniform() { return std::uniform_real_distribution<double>(0.0, 1.0)(rng_); }
+
+    SearchSpace::Point random_point() {
+        SearchSpace::Point u;
+        for (double& x : u) x = uniform();
+        return u;
+    }
+
+    // Decode and reserve a point; false when it maps to an already proposed parameter set
+    bool claim(const SearchSpace::Point& u, std::vector<ParameterSet>& batch) {
+        ParameterSet params = space_.decode(u);
+        if (!seen_.insert(parameter_key(params)).second) return false;
+        batch.push_back(std::move(params));
+        ++proposed_;
+        return true;
+    }
+
+public:
+    void observe(const std::vector<OptimizationResult>& results) override {
+        for (const auto& result : results) {
+            double score = objective_(result);
+            scores_[parameter_key(result.parameters)] = score;
+            history_.emplace_back(space_.encode(result.parameters), score);
+        }
+    }
+};
+
+/**
+ * Uniform random sampling of the search space
+ */
+class RandomSearch : public BudgetedSearch {
+public:
+    RandomSearch(SearchSpace space, size_t budget, uint64_t seed = 42, Objective objective = nullptr)
+        : BudgetedSearch(std::move(space), budget, seed, std::move(objective)) {}
+
+    const char* name() const override { return "random"; }
+
+    std::vector<ParameterSet> propose(size_t max_count) override {
+        std::vector<ParameterSet> batch;
+        size_t attempts = 0;
+        while (batch.size() < max_count && remaining() > 0 && attempts++ < 20 * max_count) {
+            claim(random_point(), batch);
+        }
+        return batch;
+    }
+};
+
+/**
+ * Latin hypercube design: every dimension's range is cut into `budget` strata
+ * and each stratum is sampled exactly once, so even a small budget covers each
+ * parameter evenly. The whole design is drawn up front.
+ */
+class LatinHypercubeSearch : public BudgetedSearch {
+private:
+    std::vector<SearchSpace::Point> design_;
+    size_t next_ = 0;
+
+public:
+    LatinHypercubeSearch(SearchSpace space, size_t samples, uint64_t seed = 42, Objective objective = nullptr)
+        : BudgetedSearch(std::move(space), samples, seed, std::move(objective)), design_(samples) {
+        std::vector<size_t> strata(samples);
+        for (size_t d = 0; d < SearchSpace::DIMENSIONS; ++d) {
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), rng_);
+            for (size_t i = 0; i < samples; ++i) {
+                design_[i][d] = (strata[i] + uniform()) / samples;
+            }
+        }
+    }
+
+    const char* name() const override { return "lhs"; }
+
+    std::vector<ParameterSet> propose(size_t max_count) override {
+        std::vector<ParameterSet> batch;
+        while (batch.size() < max_count && next_ < design_.size()) {
+            claim(design_[next_++], batch);  // Cells that round to the same parameter set are skipped
+        }
+        return batch;
+    }
+};
+
+/**
+ * Tree-structured Parzen estimator style Bayesian search
+ *
+ * After `startup` random evaluations the history is split into the best
+ * `gamma` fraction ("good") and the rest ("bad"). Candidates are drawn around
+ * good points and the one maximizing l(x) / g(x) - the ratio of the good and
+ * bad Parzen (Gaussian kernel) densities, per dimension in the unit cube - is
+ * proposed.
+ */
+class TPESearch : public BudgetedSearch {
+private:
+    size_t startup_;
+    double gamma_;
+    size_t candidates_;
+
+    static double bandwidth(size_t count) {
+        return std::max(0.03, 0.25 / std::pow(static_cast<double>(std::max<size_t>(count, 1)), 0.2));
+    }
+
+    // log of a product-of-dimensions Gaussian KDE, mixed with a uniform prior so it never hits zero
+    static double log_density(const SearchSpace::Point& x, const std::vector<const SearchSpace::Point*>& points) {
+        const double h = bandwidth(points.size());
+        const double norm = 1.0 / (h * std::sqrt(2.0 * 3.14159265358979323846));
+        double log_p = 0.0;
+        for (size_t d = 0; d < SearchSpace::DIMENSIONS; ++d) {
+            double sum = 0.0;
+            for (const auto* p : points) {
+                double z = (x[d] - (*p)[d]) / h;
+                sum += norm * std::exp(-0.5 * z * z);
+            }
+            double n = static_cast<double>(points.size());
+            log_p += std::log((sum + 1.0) / (n + 1.0));  // Uniform prior counts as one extra point
+        }
+        return log_p;
+    }
+
+    SearchSpace::Point suggest(const std::vector<const SearchSpace::Point*>& good,
+                               const std::vector<const SearchSpace::Point*>& bad) {
+        const double h = bandwidth(good.size());
+        std::normal_distribution<double> noise(0.0, h);
+        std::uniform_int_distribution<size_t> pick(0, good.size() - 1);
+
+        SearchSpace::Point best{};
+        double best_ratio = -1e300;
+        for (size_t c = 0; c < candidates_; ++c) {
+            const SearchSpace::Point& centre = *good[pick(rng_)];
+            SearchSpace::Point x;
+            for (size_t d = 0; d < SearchSpace::DIMENSIONS; ++d) {
+                x[d] = std::clamp(centre[d] + noise(rng_), 0.0, 1.0);
+            }
+            double ratio = log_density(x, good) - log_density(x, bad);
+            if (ratio > best_ratio) {
+                best_ratio = ratio;
+                best = x;
+            }
+        }
+        return best;
+    }
+
+public:
+    TPESearch(SearchSpace space, size_t budget, uint64_t seed = 42, Objective objective = nullptr,
+              size_t startup = 16, double gamma = 0.25, size_t candidates = 32)
+        : BudgetedSearch(std::move(space), budget, seed, std::move(objective)),
+          startup_(startup), gamma_(std::clamp(gamma, 0.01, 0.99)), candidates_(std::max<size_t>(candidates, 1)) {}
+
+    const char* name() const override { return "tpe"; }
+
+    std::vector<ParameterSet> propose(size_t max_count) override {
+        std::vector<ParameterSet> batch;
+
+        // Random start-up phase until there is enough history to split
+        const size_t startup = std::max<size_t>(startup_, 2);
+        if (history_.size() < startup) {
+            size_t want = std::min(max_count, startup - history_.size());
+            size_t attempts = 0;
+            while (batch.size() < want && remaining() > 0 && attempts++ < 20 * max_count) {
+                claim(random_point(), batch);
+            }
+            return batch;
+        }
+
+        // Split the history by score
+        std::vector<size_t> order(history_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return history_[a].second > history_[b].second; });
+        size_t n_good = std::max<size_t>(1, static_cast<size_t>(std::ceil(gamma_ * history_.size())));
+        std::vector<const SearchSpace::Point*> good, bad;
+        for (size_t i = 0; i < order.size(); ++i) {
+            (i < n_good ? good : bad).push_back(&history_[order[i]].first);
+        }
+
+        size_t attempts = 0;
+        while (batch.size() < max_count && remaining() > 0 && attempts++ < 20 * max_count) {
+            claim(suggest(good, bad), batch);
+        }
+        return batch;
+    }
+};
+
+/**
+ * Parallel coordinate descent (pattern search)
+ *
+ * From the current centre every dimension is probed one step up and one step
+ * down - one batch of up to 2 * DIMENSIONS backtests. The centre moves to the
+ * best probe if it improves on the centre; otherwise the step is halved. The
+ * search ends when the step drops below min_step or the budget is spent.
+ */
+class CoordinateDescentSearch : public BudgetedSearch {
+private:
+    SearchSpace::Point centre_;
+    double step_;
+    double min_step_;
+    bool centre_proposed_ = false;
+    std::vector<Key> probes_;   // Keys of the last batch of probes
+
+    double score_of(const Key& key) const {
+        auto it = scores_.find(key);
+        return it == scores_.end() ? -1e300 : it->second;
+    }
+
+public:
+    CoordinateDescentSearch(SearchSpace space, size_t budget, double initial_step = 0.25, double min_step = 1.0 / 64,
+                            Objective objective = nullptr)
+        : BudgetedSearch(std::move(space), budget, 0, std::move(objective)),
+          step_(initial_step), min_step_(min_step) {
+        centre_.fill(0.5);
+    }
+
+    // Begin the descent from a known parameter set instead of the middle of the space
+    void set_start(const ParameterSet& start) { centre_ = space_.encode(start); }
+
+    const char* name() const override { return "coordinate"; }
+
+    std::vector<ParameterSet> propose(size_t max_count) override {
+        std::vector<ParameterSet> batch;
+        if (!centre_proposed_) {
+            centre_proposed_ = true;
+            if (remaining() > 0) claim(centre_, batch);
+            return batch;
+        }
+
+        Key centre_key = parameter_key(space_.decode(centre_));
+        while (batch.empty() && step_ >= min_step_ && remaining() > 0) {
+            // Move to the best probe of the previous round, or shrink the step
+            if (!probes_.empty()) {
+                const Key* best = &centre_key;
+                for (const auto& probe : probes_) {
+                    if (score_of(probe) > score_of(*best)) best = &probe;
+                }
+                if (best != &centre_key) {
+                    for (const auto& [point, score] : history_) {
+                        if (parameter_key(space_.decode(point)) == *best) {
+                            centre_ = point;
+                            break;
+                        }
+                    }
+                    centre_key = *best;
+                } else {
+                    step_ /= 2.0;
+                }
+                probes_.clear();
+                if (step_ < min_step_) break;
+            }
+
+            for (size_t d = 0; d < SearchSpace::DIMENSIONS && batch.size() < max_count && remaining() > 0; ++d) {
+                for (double direction : {-1.0, 1.0}) {
+                    SearchSpace::Point probe = centre_;
+                    probe[d] = std::clamp(probe[d] + direction * step_, 0.0, 1.0);
+                    Key key = parameter_key(space_.decode(probe));
+                    if (key == centre_key) continue;
+                    if (scores_.count(key)) {
+                        probes_.push_back(key);       // Already evaluated: compare without rerunning
+                    } else if (batch.size() < max_count && remaining() > 0 && claim(probe, batch)) {
+                        probes_.push_back(key);
+                    }
+                }
+            }
+            if (batch.empty() && probes_.empty()) step_ /= 2.0;  // Every probe rounds onto the centre
+        }
+        return batch;
+    }
+};
+
+// Driver by name ("random", "lhs", "tpe", "coordinate"); nullptr for an unknown name
+inline std::unique_ptr<SearchDriver> make_search_driver(const std::string& name, SearchSpace space,
+                                                        size_t budget, uint64_t seed = 42) {
+    if (name == "random") return std::make_unique<RandomSearch>(std::move(space), budget, seed);
+    if (name == "lhs") return std::make_unique<LatinHypercubeSearch>(std::move(space), budget, seed);
+    if (name == "tpe") return std::make_unique<TPESearch>(std::move(space), budget, seed);
+    if (name == "coordinate") return std::make_unique<CoordinateDescentSearch>(std::move(space), budget);
+    return nullptr;
+}
+
+} // namespace quantlab::optimization
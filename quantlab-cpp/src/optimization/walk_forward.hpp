@@ -0,0 +1,268 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <cstddef>
+#include <algorithm>
+#include "optimization_types.hpp"
+#include "search.hpp"
+#include "../core/data_types.hpp"
+#include "../core/parallel.hpp"
+#include "../indicators/indicator_bank.hpp"
+#include "../strategy/mean_reversion_strategy.hpp"
+#include "../backtest/backtest_engine.hpp"
+#include "../backtest/strategy_runner.hpp"
+
+namespace quantlab::optimization {
+
+/**
+ * How the bar series is split into train / test folds
+ */
+enum class ValidationMode {
+    WALK_FORWARD_ROLLING,   // Fixed-length train window sliding forward, test on the bars right after it
+    WALK_FORWARD_ANCHORED,  // Train always starts at the first bar and grows fold by fold
+    K_FOLD                  // k contiguous folds; each is the test set once, the rest is the train set
+};
+
+struct ValidationConfig {
+    ValidationMode mode = ValidationMode::WALK_FORWARD_ROLLING;
+    size_t folds = 5;
+    size_t train_bars = 0;          // Walk-forward train length (0 = same as the test length)
+    size_t test_bars = 0;           // Walk-forward test length (0 = split the series evenly)
+    size_t warmup_bars = 20;        // Indicator-only bars before the first fold
+    double starting_capital = 1000000.0;
+    size_t threads = quantlab::core::default_thread_count();
+};
+
+// Half-open bar range [begin, end)
+struct BarRange {
+    size_t begin;
+    size_t end;
+    size_t size() const { return end - begin; }
+};
+
+struct FoldResult {
+    size_t fold;
+    std::vector<BarRange> train;    // One range for walk-forward, up to two for k-fold
+    BarRange test;
+    ParameterSet best;              // Winner on the train bars
+    double train_score;             // Its objective on the train bars (bar-weighted over ranges)
+    OptimizationResult test_result; // The same configuration on the test bars
+    double test_score;
+};
+
+struct ValidationReport {
+    std::vector<FoldResult> folds;
+    double mean_train_score = 0.0;
+    double mean_test_score = 0.0;   // Out-of-sample estimate
+    size_t checkpoints = 0;         // Indicator snapshots taken
+};
+
+/**
+ * Walk-forward / k-fold cross-validation of a parameter grid on one symbol
+ *
+ * Every fold "optimizes" on its train bars (backtests each candidate and
+ * keeps the best by the objective) and then scores that winner on its test
+ * bars. Folds run in parallel.
+ *
+ * Indicators are not replayed from bar 0 per fold: a single IndicatorBank
+ * pass over the series (covering every candidate's EMA / RSI / BB period)
+ * snapshots its state at each fold boundary, and each train/test range is
+ * backtested from the snapshot at its first bar. Indicator state only ever
+ * reflects past prices, so a checkpoint is the same state a continuous run
+ * would have at that bar; positions and metrics start fresh per range, and a
+ * range's metrics are marked at its last close.
+ *
+ * Candidates are strategy configurations for the given bars; their symbol and
+ * days fields are carried through but not used.
+ */
+class WalkForwardValidator {
+private:
+    quantlab::core::BarColumnsView bars_;
+    std::vector<ParameterSet> candidates_;
+    ValidationConfig config_;
+    Objective objective_;
+
+    std::vector<int> ema_periods_, rsi_periods_, bb_periods_;
+    std::map<size_t, quantlab::indicators::IndicatorBank> checkpoints_;  // Bank state before bar `key`
+
+    std::vector<FoldResult> layout() const {
+        std::vector<FoldResult> folds;
+        const size_t n = bars_.size();
+        const size_t first = std::min(config_.warmup_bars, n);
+        const size_t usable = n - first;
+        const size_t k = std::max<size_t>(config_.folds, 1);
+
+        auto add = [&](std::vector<BarRange> train, BarRange test) {
+            train.erase(std::remove_if(train.begin(), train.end(), [](const BarRange& r) { return r.size() == 0; }),
+                        train.end());
+            if (train.empty() || test.size() == 0) return;
+            folds.push_back(FoldResult{folds.size(), std::move(train), test, candidates_.front(), 0.0,
+                                       OptimizationResult(candidates_.front()), 0.0});
+        };
+
+        if (config_.mode == ValidationMode::K_FOLD) {
+            size_t fold_size = usable / k;
+            if (fold_size == 0) return folds;
+            for (size_t i = 0; i < k; ++i) {
+                size_t test_begin = first + i * fold_size;
+                size_t test_end = (i + 1 == k) ? n : test_begin + fold_size;
+                add({{first, test_begin}, {test_end, n}}, {test_begin, test_end});
+            }
+            return folds;
+        }
+
+        size_t test = config_.test_bars ? config_.test_bars : usable / (k + 1);
+        size_t train = config_.train_bars ? config_.train_bars : test;
+        if (test == 0) return folds;
+        for (size_t i = 0; i < k; ++i) {
+            size_t test_begin = first + train + i * test;
+            size_t test_end = test_begin + test;
+            if (test_end > n) break;
+            size_t train_begin = (config_.mode == ValidationMode::WALK_FORWARD_ANCHORED) ? first : test_begin - train;
+            add({{train_begin, test_begin}}, {test_begin, test_end});
+        }
+        return folds;
+    }
+
+    // One pass over the series, copying the bank at every range start
+    void take_checkpoints(const std::set<size_t>& starts) {
+        quantlab::indicators::IndicatorBank bank(ema_periods_, rsi_periods_, bb_periods_, 2.0);
+        auto next = starts.begin();
+        for (size_t bar = 0; bar < bars_.size() && next != starts.end(); ++bar) {
+            if (bar == *next) {
+                checkpoints_.emplace(bar, bank);
+                ++next;
+            }
+            bank.update(bars_.close[bar]);
+        }
+    }
+
+    // Backtest the given candidates over one range, starting from its checkpoint
+    std::vector<OptimizationResult> backtest_range(const std::vector<size_t>& candidate_indices,
+                                                   const BarRange& range) const {
+        quantlab::indicators::IndicatorBank bank = checkpoints_.at(range.begin);
+
+        struct Lane {
+            const ParameterSet* params;
+            quantlab::strategy::MeanReversionStrategy strategy;
+            quantlab::backtest::BacktestEngine engine;
+            size_t ema_lane;
+            size_t rsi_lane;
+            size_t bb_lane;
+        };
+        std::vector<Lane> lanes;
+        lanes.reserve(candidate_indices.size());
+        for (size_t i : candidate_indices) {
+            const ParameterSet& params = candidates_[i];
+            quantlab::strategy::MeanReversionStrategy strategy(params.ema_period, params.rsi_period, params.bb_period,
+                                                               2.0, nullptr, params.rsi_oversold, params.rsi_overbought);
+            strategy.set_confidence_threshold(params.confidence_threshold);
+            lanes.push_back({&params, std::move(strategy), quantlab::backtest::BacktestEngine(config_.starting_capital),
+                             bank.ema_index(params.ema_period), bank.rsi_index(params.rsi_period),
+                             bank.bb_index(params.bb_period)});
+        }
+
+        for (size_t bar = range.begin; bar < range.end; ++bar) {
+            const double close = bars_.close[bar];
+            bank.update(close);
+            const auto market = quantlab::backtest::market_event(bars_, bar);
+            for (auto& lane : lanes) {
+                auto signal_result = lane.strategy.evaluate(close, bank.ema(lane.ema_lane), bank.rsi(lane.rsi_lane),
+                                                            bank.bands(lane.bb_lane));
+                signal_result.timestamp_ns = bars_.timestamp_ns[bar];
+                lane.engine.on_bar(market);
+                quantlab::backtest::route_signal(lane.engine, signal_result, lane.params->confidence_threshold);
+            }
+        }
+
+        std::vector<OptimizationResult> results;
+        results.reserve(lanes.size());
+        const double final_price = bars_.close[range.end - 1];
+        for (auto& lane : lanes) {
+            lane.engine.calculate_final_metrics(final_price);
+            const auto& metrics = lane.engine.get_metrics();
+            OptimizationResult result(*lane.params);
+            result.total_return = metrics.total_return_pct / 100.0;
+            result.max_drawdown = metrics.max_drawdown_pct;
+            result.sharpe_ratio = metrics.sharpe_ratio;
+            result.total_trades = metrics.total_trades;
+            result.winning_trades = metrics.winning_trades;
+            result.win_rate = metrics.win_rate_pct;
+            result.profit_factor = metrics.profit_factor;
+            result.bars_evaluated = range.size();
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    void run_fold(FoldResult& fold) const {
+        std::vector<size_t> all(candidates_.size());
+        for (size_t i = 0; i < all.size(); ++i) all[i] = i;
+
+        // Train: bar-weighted objective over the train ranges, best candidate wins (ties: grid order)
+        std::vector<double> scores(candidates_.size(), 0.0);
+        size_t train_bars = 0;
+        for (const auto& range : fold.train) {
+            auto results = backtest_range(all, range);
+            for (size_t i = 0; i < results.size(); ++i) {
+                scores[i] += objective_(results[i]) * range.size();
+            }
+            train_bars += range.size();
+        }
+        size_t best = static_cast<size_t>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+        fold.best = candidates_[best];
+        fold.train_score = scores[best] / train_bars;
+
+        // Test: the winner only
+        fold.test_result = backtest_range({best}, fold.test).front();
+        fold.test_score = objective_(fold.test_result);
+    }
+
+public:
+    WalkForwardValidator(quantlab::core::BarColumnsView bars, std::vector<ParameterSet> candidates,
+                         ValidationConfig config = {}, Objective objective = nullptr)
+        : bars_(bars), candidates_(std::move(candidates)), config_(config),
+          objective_(objective ? std::move(objective) : Objective(total_return_objective)) {
+        for (const auto& params : candidates_) {
+            ema_periods_.push_back(params.ema_period);
+            rsi_periods_.push_back(params.rsi_period);
+            bb_periods_.push_back(params.bb_period);
+        }
+    }
+
+    ValidationReport run() {
+        ValidationReport report;
+        if (candidates_.empty()) return report;
+
+        report.folds = layout();
+        if (report.folds.empty()) {
+            std::cerr << "⚠️  Not enough bars (" << bars_.size() << ") for " << config_.folds << " folds" << std::endl;
+            return report;
+        }
+
+        std::set<size_t> starts;
+        for (const auto& fold : report.folds) {
+            for (const auto& range : fold.train) starts.insert(range.begin);
+            starts.insert(fold.test.begin);
+        }
+        checkpoints_.clear();
+        take_checkpoints(starts);
+        report.checkpoints = checkpoints_.size();
+
+        quantlab::core::parallel_for(report.folds.size(), config_.threads, [&](size_t f) {
+            run_fold(report.folds[f]);
+        });
+
+        for (const auto& fold : report.folds) {
+            report.mean_train_score += fold.train_score;
+            report.mean_test_score += fold.test_score;
+        }
+        report.mean_train_score /= report.folds.size();
+        report.mean_test_score /= report.folds.size();
+        return report;
+    }
+};
+
+} // namespace quantlab::optimization
@@ -1,13 +1,19 @@
 #pragma once
 
 #include "../core/data_types.hpp"
+#include "../core/signal_types.hpp"
+#include "../core/state_io.hpp"
+#include "../core/time_utils.hpp"
+#include "../core/profiler.hpp"
 #include "../indicators/rolling_ema.hpp"
 #include "../indicators/rsi.hpp"
 #include "../indicators/bollinger_bands.hpp"
-#include "../data/alpaca_client.hpp"
+#include "../data/data_source.hpp"
 #include <string>
 #include <vector>
+#include <span>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 namespace quantlab::strategy {
@@ -28,7 +34,8 @@ enum class Signal {
 struct StrategyResult {
     Signal signal;
     double confidence;  // 0.0 to 1.0
-    std::string reason; // Human-readable explanation
+    quantlab::core::SignalReason reason; // Explanation, formatted on demand (reason.to_string())
+    int64_t timestamp_ns = 0;            // Bar time (backtest) or 0 for live signals
     
     // Current indicator values for analysis
     double current_price;
@@ -40,7 +47,7 @@ struct StrategyResult {
     
     StrategyResult() : signal(Signal::NONE), confidence(0.0) {}
     
-    StrategyResult(Signal sig, double conf, const std::string& r) 
+    StrategyResult(Signal sig, double conf, const quantlab::core::SignalReason& r) 
         : signal(sig), confidence(conf), reason(r) {}
 };
 
@@ -65,21 +72,51 @@ private:
     quantlab::indicators::RSI rsi_;
     quantlab::indicators::BollingerBands bb_;
     
+    // Scratch copies preview_signal() steps instead of the indicators (kept so no quote allocates)
+    quantlab::indicators::RollingEMA preview_ema_;
+    quantlab::indicators::RSI preview_rsi_;
+    quantlab::indicators::BollingerBands preview_bb_;
+    
     // Strategy parameters
     int rsi_oversold_threshold_;   // Default: 30
     int rsi_overbought_threshold_; // Default: 70
     double confidence_threshold_;  // Default: 0.65
     
-    // Market data client
-    quantlab::data::AlpacaClient* market_data_;
+    // Market data source (AlpacaClient, SyntheticDataSource, ...); null = bars are supplied directly
+    quantlab::data::DataSource* market_data_;
     
     // Historical data for backtesting
-    std::vector<quantlab::core::Bar> historical_bars_;
+    quantlab::core::BarColumns historical_bars_;  // Owned columnar storage filled by the load_* methods
+    quantlab::core::BarColumnsView bars_;         // What backtest() runs on (owned or borrowed)
+    
+    // Newest bar the indicators have seen (0 = none yet); incremental runs resume after it
+    int64_t last_timestamp_ns_ = 0;
+    
+    // Series the indicators were warmed up on ("" when the bars came from use_historical_data)
+    std::string state_symbol_;
+    std::string state_timeframe_;
+    
+    // Snapshot format (see save_state)
+    static constexpr char STATE_MAGIC[8] = {'Q', 'L', 'S', 'T', 'R', 'A', 'T', '\0'};
+    static constexpr uint32_t STATE_VERSION = 2;
+    
+    // Feed a price series through all three indicators
+    void warm_up(std::span<const double> closes) {
+        QUANTLAB_PROFILE_SCOPE(INDICATORS);
+        for (double close : closes) {
+            warm_up_bar(close);
+        }
+    }
+    
+    void warm_up(const quantlab::core::BarColumnsView& bars) {
+        warm_up(bars.close);
+        if (!bars.empty()) last_timestamp_ns_ = bars.timestamp_ns.back();
+    }
     
 public:
     // Simplified constructor for easy initialization
-    MeanReversionStrategy(std::shared_ptr<quantlab::data::AlpacaClient> client)
-        : ema_(20), rsi_(14), bb_(20, 2.0), 
+    MeanReversionStrategy(std::shared_ptr<quantlab::data::DataSource> client)
+        : ema_(20), rsi_(14), bb_(20, 2.0), preview_ema_(ema_), preview_rsi_(rsi_), preview_bb_(bb_),
           rsi_oversold_threshold_(30), rsi_overbought_threshold_(70), 
           confidence_threshold_(0.65),
           market_data_(client.get()), historical_bars_() {
@@ -87,9 +124,10 @@ public:
     
     // Full constructor for custom parameters
     MeanReversionStrategy(int ema_period, int rsi_period, int bb_period, double bb_std_dev,
-                         quantlab::data::AlpacaClient* client,
+                         quantlab::data::DataSource* client,
                          int rsi_oversold = 30, int rsi_overbought = 70, double confidence = 0.65) 
-        : ema_(ema_period), rsi_(rsi_period), bb_(bb_period, bb_std_dev), 
+        : ema_(ema_period), rsi_(rsi_period), bb_(bb_period, bb_std_dev),
+          preview_ema_(ema_), preview_rsi_(rsi_), preview_bb_(bb_),
           rsi_oversold_threshold_(rsi_oversold), rsi_overbought_threshold_(rsi_overbought), 
           confidence_threshold_(confidence),
           market_data_(client), historical_bars_() {
@@ -98,17 +136,28 @@ public:
     // Load historical data and warm up indicators
     void load_historical_data(const std::string& symbol, const std::string& timeframe, int limit) {
         // Get historical data with empty start/end dates (use default behavior)
-        historical_bars_ = market_data_->get_historical_bars(symbol, timeframe, "", "");
+        historical_bars_ = market_data_->get_historical_bar_columns(symbol, timeframe, "", "");
+        bars_ = historical_bars_.view();
+        state_symbol_ = symbol;
+        state_timeframe_ = timeframe;
         std::cout << "Loaded " << historical_bars_.size() << " historical bars for long-term analysis" << std::endl;
         
         // Feed all bars to indicators to warm them up
-        for(const auto& bar : historical_bars_) {
-            ema_.update(bar.close);
-            rsi_.update(bar.close);
-            bb_.update(bar.close);
-        }
+        warm_up(bars_);
+    }
+    
+    // Backtest on bars owned elsewhere (e.g. a slice of a shared per-symbol history)
+    // No copy is made - the caller keeps the storage alive. Indicators are left cold; backtest() resets them anyway.
+    void use_historical_data(quantlab::core::BarColumnsView bars) {
+        historical_bars_.clear();
+        bars_ = bars;
+        state_symbol_.clear();
+        state_timeframe_.clear();
     }
     
+    // Bars backtest() runs on
+    const quantlab::core::BarColumnsView& bars() const { return bars_; }
+    
     // Set confidence threshold for trading signals
     void set_confidence_threshold(double threshold) {
         if (threshold > 0.0 && threshold <= 1.0) {
@@ -119,23 +168,159 @@ public:
     // ENHANCED: Multi-minute aggregated data loading for extended analysis
     void load_aggregated_historical_data(const std::string& symbol, const std::string& timeframe, int total_days, int days_per_call = 1) {
         // Load historical data using aggregated method
-        historical_bars_ = market_data_->get_aggregated_historical_bars(symbol, timeframe, total_days, days_per_call);
+        historical_bars_ = quantlab::core::BarColumns(
+            market_data_->get_aggregated_historical_bars(symbol, timeframe, total_days, days_per_call));
+        bars_ = historical_bars_.view();
+        state_symbol_ = symbol;
+        state_timeframe_ = timeframe;
         
         // Initialize indicators with historical data
-        int bars_processed = 0;
-        for(const auto& bar : historical_bars_) {
-            ema_.update(bar.close);
-            rsi_.update(bar.close);
-            bb_.update(bar.close);
-            bars_processed++;
-        }
+        warm_up(bars_);
         
         // Strategy initialized with historical data
     }
     
+    // INCREMENTAL DAILY RUNS - persist the warmed-up indicators instead of reloading the history
+    //
+    // Typical day:   restore_state_file(path, symbol, tf) -> catch_up(symbol, tf) -> save_state_file(path) -> generate_signal()
+    // Save before generate_signal(): it feeds the live quote into the indicators, and that
+    // intrabar price must not end up in the persisted state.
+    //
+    // Blob layout (native byte order, like the bar cache):
+    //   "QLSTRAT\0" | u32 version | u32 reserved | string symbol | string timeframe | i32 oversold |
+    //   i32 overbought | f64 confidence | i64 last bar timestamp | EMA state | RSI state | Bollinger state
+    // Indicator periods are part of their state; a snapshot from a differently configured
+    // strategy is rejected, and so is one of another symbol / timeframe than the caller asks for.
+    std::vector<uint8_t> save_state() const {
+        quantlab::core::StateWriter out;
+        out.write(STATE_MAGIC);
+        out.write<uint32_t>(STATE_VERSION);
+        out.write<uint32_t>(0);
+        out.write_string(state_symbol_);
+        out.write_string(state_timeframe_);
+        out.write<int32_t>(rsi_oversold_threshold_);
+        out.write<int32_t>(rsi_overbought_threshold_);
+        out.write(confidence_threshold_);
+        out.write(last_timestamp_ns_);
+        ema_.save_state(out);
+        rsi_.save_state(out);
+        bb_.save_state(out);
+        return out.take();
+    }
+    
+    // All or nothing: on failure the strategy keeps its current state
+    // A non-empty symbol / timeframe must match the one the snapshot was taken on.
+    bool restore_state(std::span<const uint8_t> blob, const std::string& symbol = "",
+                       const std::string& timeframe = "") {
+        quantlab::core::StateReader in(blob);
+        char magic[sizeof(STATE_MAGIC)] = {};
+        uint32_t version = 0, reserved = 0;
+        if (!in.read(magic) || std::memcmp(magic, STATE_MAGIC, sizeof(magic)) != 0) {
+            std::cerr << "❌ Error: Not a strategy state snapshot" << std::endl;
+            return false;
+        }
+        if (!in.read(version) || version != STATE_VERSION || !in.read(reserved)) {
+            std::cerr << "❌ Error: Unsupported strategy state version " << version
+                      << " (expected " << STATE_VERSION << ")" << std::endl;
+            return false;
+        }
+        
+        std::string saved_symbol, saved_timeframe;
+        if (!in.read_string(saved_symbol) || !in.read_string(saved_timeframe)) {
+            std::cerr << "❌ Error: Strategy state snapshot is truncated" << std::endl;
+            return false;
+        }
+        if ((!symbol.empty() && saved_symbol != symbol) || (!timeframe.empty() && saved_timeframe != timeframe)) {
+            std::cerr << "❌ Error: Strategy state snapshot is for " << (saved_symbol.empty() ? "?" : saved_symbol)
+                      << " " << (saved_timeframe.empty() ? "?" : saved_timeframe) << ", not " << symbol << " "
+                      << timeframe << std::endl;
+            return false;
+        }
+        
+        int32_t oversold = 0, overbought = 0;
+        double confidence = 0.0;
+        int64_t last_timestamp_ns = 0;
+        auto ema = ema_;
+        auto rsi = rsi_;
+        auto bb = bb_;
+        if (!in.read(oversold) || !in.read(overbought) || !in.read(confidence) || !in.read(last_timestamp_ns) ||
+            !ema.load_state(in) || !rsi.load_state(in) || !bb.load_state(in) || !in.at_end()) {
+            std::cerr << "❌ Error: Strategy state snapshot is truncated or was saved with different indicator periods"
+                      << std::endl;
+            return false;
+        }
+        
+        rsi_oversold_threshold_ = oversold;
+        rsi_overbought_threshold_ = overbought;
+        confidence_threshold_ = confidence;
+        last_timestamp_ns_ = last_timestamp_ns;
+        state_symbol_ = std::move(saved_symbol);
+        state_timeframe_ = std::move(saved_timeframe);
+        ema_ = ema;
+        rsi_ = rsi;
+        bb_ = std::move(bb);
+        return true;
+    }
+    
+    bool save_state_file(const std::string& path) const {
+        return quantlab::core::write_state_file(path, save_state());
+    }
+    
+    // False if the file is missing or unusable; the caller then falls back to a full load
+    bool restore_state_file(const std::string& path, const std::string& symbol = "",
+                            const std::string& timeframe = "") {
+        auto blob = quantlab::core::read_state_file(path);
+        if (!blob.has_value()) {
+            std::cerr << "⚠️  No strategy state at " << path << std::endl;
+            return false;
+        }
+        return restore_state(*blob, symbol, timeframe);
+    }
+    
+    int64_t last_bar_timestamp_ns() const { return last_timestamp_ns_; }
+    
+    // Feed only the bars newer than the last one seen (overlap with a previous run is skipped)
+    // Returns the number of bars applied.
+    size_t update_with_bars(const quantlab::core::BarColumnsView& bars) {
+        size_t first = static_cast<size_t>(
+            std::upper_bound(bars.timestamp_ns.begin(), bars.timestamp_ns.end(), last_timestamp_ns_) -
+            bars.timestamp_ns.begin());
+        warm_up(bars.subview(first));
+        return bars.size() - first;
+    }
+    
+    // Fetch the completed bars since the last one seen and feed them to the indicators
+    // The request starts on the last bar's day so nothing is missed; update_with_bars drops the overlap.
+    // Bars from today (UTC) are dropped: during market hours today's bar is still forming, and
+    // whatever is applied here ends up in the saved state. The next run picks it up once closed.
+    size_t catch_up(const std::string& symbol, const std::string& timeframe = "1Day") {
+        if (last_timestamp_ns_ == 0) {
+            std::cerr << "⚠️  No state to catch up from - load history first" << std::endl;
+            return 0;
+        }
+        if (state_symbol_ != symbol || state_timeframe_ != timeframe) {
+            std::cerr << "❌ Error: Indicator state is for " << (state_symbol_.empty() ? "?" : state_symbol_) << " "
+                      << (state_timeframe_.empty() ? "?" : state_timeframe_) << " - cannot catch up on "
+                      << symbol << " " << timeframe << std::endl;
+            return 0;
+        }
+        if (!market_data_) {
+            std::cerr << "❌ Error: No market data client to catch up with" << std::endl;
+            return 0;
+        }
+        std::string start = quantlab::core::date_from_epoch_day(
+            quantlab::core::epoch_day_from_nanoseconds(last_timestamp_ns_));
+        quantlab::core::BarColumns fresh = market_data_->get_historical_bar_columns(symbol, timeframe, start, "");
+        auto bars = fresh.view();
+        const int64_t today_ns = static_cast<int64_t>(quantlab::core::today_epoch_day()) * quantlab::core::NANOS_PER_DAY;
+        size_t completed = static_cast<size_t>(
+            std::lower_bound(bars.timestamp_ns.begin(), bars.timestamp_ns.end(), today_ns) - bars.timestamp_ns.begin());
+        return update_with_bars(bars.subview(0, completed));
+    }
+    
     // INSTITUTIONAL-GRADE WEIGHTED CONFIDENCE SYSTEM
     // Based on how professional hedge funds and institutional traders calculate confidence
-    double calculate_confidence(double price, double ema, double rsi, double bb_upper, double bb_middle, double bb_lower) {
+    double calculate_confidence(double price, double ema, double rsi, double bb_upper, double bb_middle, double bb_lower) const {
         double total_score = 0.0;
         double total_weight = 0.0;
         
@@ -204,6 +389,7 @@ public:
     }
 
     // CHALLENGE 3: Generate trading signal based on current market conditions
+    // One blocking REST round trip per call; streaming callers use generate_signal(price) instead
     StrategyResult generate_signal(const std::string& symbol) {
         // Get latest price using quote API
         auto quote_opt = market_data_->get_latest_quote(symbol);
@@ -211,16 +397,36 @@ public:
             StrategyResult result;
             result.signal = Signal::HOLD;  
             result.confidence = 0.0;
-            result.reason = "No quote data available";
+            result.reason.code = quantlab::core::ReasonCode::NO_QUOTE;
             return result;
         }
         
-        double latest_price = quote_opt->mid_price(); // Use mid price from bid/ask
+        return generate_signal(quote_opt->mid_price()); // Use mid price from bid/ask
+    }
+    
+    // Feed a live price into the indicators and signal on it (one call per bar, e.g. a daily run)
+    StrategyResult generate_signal(double latest_price) {
         ema_.update(latest_price);
         rsi_.update(latest_price);
         auto bb_result = bb_.update(latest_price);  // Use the return value directly
-        double ema_value = ema_.value();
-        double rsi_value = rsi_.value();
+        return live_signal(latest_price, ema_.value(), rsi_.value(), bb_result);
+    }
+    
+    // Signal a live price (e.g. every streamed quote's mid) as if it closed the next bar, leaving the
+    // indicators untouched: warmed on daily bars, they stay daily however many quotes are scored
+    StrategyResult preview_signal(double latest_price) {
+        preview_ema_ = ema_;
+        preview_rsi_ = rsi_;
+        preview_bb_ = bb_;
+        preview_ema_.update(latest_price);
+        preview_rsi_.update(latest_price);
+        auto bb_result = preview_bb_.update(latest_price);
+        return live_signal(latest_price, preview_ema_.value(), preview_rsi_.value(), bb_result);
+    }
+    
+private:
+    StrategyResult live_signal(double latest_price, double ema_value, double rsi_value,
+                               const quantlab::indicators::BollingerBandsResult& bb_result) const {
         double bb_upper = bb_result.upper_band;
         double bb_middle = bb_result.middle_band;
         double bb_lower = bb_result.lower_band;
@@ -243,110 +449,134 @@ public:
         if(rsi_value < rsi_oversold_threshold_ && confidence >= confidence_threshold_) {
             result.signal = Signal::BUY;
             result.confidence = confidence;
-            result.reason = "INSTITUTIONAL BUY: RSI=" + std::to_string((int)rsi_value) + 
-                           " (oversold<30). Confidence=" + 
-                           std::to_string((int)(confidence*100)) + "%";
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERSOLD, rsi_value, confidence, confidence_threshold_};
         }
         else if(rsi_value > rsi_overbought_threshold_ && confidence >= confidence_threshold_) {
             result.signal = Signal::SELL;
             result.confidence = confidence;
-            result.reason = "INSTITUTIONAL SELL: RSI=" + std::to_string((int)rsi_value) + 
-                           " (overbought>70). Confidence=" + 
-                           std::to_string((int)(confidence*100)) + "%";
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERBOUGHT, rsi_value, confidence, confidence_threshold_};
         }
         else {
             result.signal = Signal::HOLD;
             result.confidence = confidence;
-            result.reason = "HOLD: Confidence=" + std::to_string((int)(confidence*100)) + 
-                           "% (need >" + std::to_string((int)(confidence_threshold_*100)) + "% for signal)";
+            result.reason = {quantlab::core::ReasonCode::HOLD_LOW_CONFIDENCE, rsi_value, confidence, confidence_threshold_};
         }
         
         return result;
     }
     
-    // PROFESSIONAL BACKTESTING ENGINE
-    std::vector<StrategyResult> backtest() {
-        std::vector<StrategyResult> results;
+public:
+    // Bars fed to the indicators before backtest() starts emitting signals
+    static size_t warmup_bars(size_t bar_count) {
+        size_t warmup_periods = 20;  // Conservative warmup period for all indicators
+        return std::min(warmup_periods, bar_count / 2);
+    }
+    
+    // Backtest signal for one bar given this bar's indicator values
+    // Shared by backtest() and callers that compute indicators elsewhere (e.g. an IndicatorBank sweep)
+    StrategyResult evaluate(double close, double ema_value, double rsi_value,
+                            const quantlab::indicators::BollingerBandsResult& bands) const {
+        double bb_upper = bands.upper_band;
+        double bb_middle = bands.middle_band;
+        double bb_lower = bands.lower_band;
+        
+        // Calculate confidence and signal
+        double confidence = calculate_confidence(close, ema_value, rsi_value, bb_upper, bb_middle, bb_lower);
         
-        if (historical_bars_.empty()) {
+        StrategyResult result;
+        result.current_price = close;
+        result.ema_value = ema_value;
+        result.rsi_value = rsi_value;
+        result.bb_upper = bb_upper;
+        result.bb_middle = bb_middle;
+        result.bb_lower = bb_lower;
+        result.confidence = confidence;
+        
+        // Generate signal based on strategy logic
+        bool rsi_oversold = rsi_value < rsi_oversold_threshold_;
+        bool rsi_overbought = rsi_value > rsi_overbought_threshold_;
+        bool high_confidence = confidence >= confidence_threshold_;
+        
+        // FIXED LOGIC: Simple mean reversion conditions matching generate_signal method
+        if (rsi_oversold && high_confidence) {
+            result.signal = Signal::BUY;
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERSOLD, rsi_value, confidence, confidence_threshold_};
+        }
+        else if (rsi_overbought && high_confidence) {
+            result.signal = Signal::SELL;
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERBOUGHT, rsi_value, confidence, confidence_threshold_};
+        }
+        else {
+            result.signal = Signal::HOLD;
+            result.reason = {quantlab::core::ReasonCode::HOLD, rsi_value, confidence, confidence_threshold_};
+        }
+        
+        return result;
+    }
+    
+    // INCREMENTAL API - drive the strategy one bar at a time (e.g. from a merged multi-symbol timeline)
+    void reset_indicators() {
+        ema_.reset();
+        rsi_.reset();
+        bb_.reset();
+    }
+    
+    // Indicator update only, for warm-up bars that must not produce signals
+    void warm_up_bar(double close) {
+        ema_.update(close);
+        rsi_.update(close);
+        bb_.update(close);
+    }
+    
+    // Update the indicators with this bar's close and return the bar's signal
+    StrategyResult on_bar(double close) {
+        ema_.update(close);
+        rsi_.update(close);
+        auto bb_result = bb_.update(close);
+        return evaluate(close, ema_.value(), rsi_.value(), bb_result);
+    }
+    
+    // PROFESSIONAL BACKTESTING ENGINE (streaming)
+    // Each bar's signal is handed to on_signal(const StrategyResult&) as soon as it is computed, so
+    // callers can drive a portfolio in the same loop. Nothing is accumulated: memory stays constant
+    // however long the history is. Returns the number of signals emitted.
+    template<typename SignalSink>
+    size_t backtest(SignalSink&& on_signal) {
+        if (bars_.empty()) {
             std::cout << "Error: No historical data available for backtesting!" << std::endl;
-            return results;
+            return 0;
         }
         
-        std::cout << "Running backtest on " << historical_bars_.size() << " data points..." << std::endl;
+        std::cout << "Running backtest on " << bars_.size() << " data points..." << std::endl;
+        QUANTLAB_PROFILE_SCOPE(SIGNALS);
         
         // Reset indicators for clean backtest
-        ema_.reset();
-        rsi_.reset();  
-        bb_.reset();
+        reset_indicators();
         
         // Warm up indicators with first portion of data (use conservative estimate)
-        size_t warmup_periods = 20;  // Conservative warmup period for all indicators
-        warmup_periods = std::min(warmup_periods, historical_bars_.size() / 2);
+        size_t warmup_periods = warmup_bars(bars_.size());
         
-        for (size_t i = 0; i < warmup_periods && i < historical_bars_.size(); ++i) {
-            ema_.update(historical_bars_[i].close);
-            rsi_.update(historical_bars_[i].close);
-            bb_.update(historical_bars_[i].close);
-        }
+        // Cache-friendly pass over the contiguous close column
+        std::span<const double> closes = bars_.close;
+        warm_up(closes.first(warmup_periods));
         
         // Generate signals for remaining data
-        for (size_t i = warmup_periods; i < historical_bars_.size(); ++i) {
-            const auto& bar = historical_bars_[i];
-            
-            // Update indicators
-            ema_.update(bar.close);
-            rsi_.update(bar.close);
-            auto bb_result = bb_.update(bar.close);
-            
-            // Calculate confidence and signal
-            double ema_value = ema_.value();
-            double rsi_value = rsi_.value();
-            double bb_upper = bb_result.upper_band;
-            double bb_middle = bb_result.middle_band;
-            double bb_lower = bb_result.lower_band;
-            
-            double confidence = calculate_confidence(bar.close, ema_value, rsi_value, bb_upper, bb_middle, bb_lower);
-            
-            // Analyze indicators for signal generation
-            
-            StrategyResult result;
-            result.current_price = bar.close;
-            result.ema_value = ema_value;
-            result.rsi_value = rsi_value;
-            result.bb_upper = bb_upper;
-            result.bb_middle = bb_middle;
-            result.bb_lower = bb_lower;
-            result.confidence = confidence;
-            
-            // Generate signal based on strategy logic
-            bool rsi_oversold = rsi_value < rsi_oversold_threshold_;
-            bool rsi_overbought = rsi_value > rsi_overbought_threshold_;
-            bool price_below_bb_lower = bar.close < bb_lower;
-            bool price_above_bb_upper = bar.close > bb_upper;
-            bool price_above_ema = bar.close > ema_value;
-            bool price_below_ema = bar.close < ema_value;
-            bool high_confidence = confidence >= confidence_threshold_;
-            
-            // FIXED LOGIC: Simple mean reversion conditions matching generate_signal method
-            if (rsi_oversold && high_confidence) {
-                result.signal = Signal::BUY;
-                result.reason = "BUY: RSI=" + std::to_string((int)rsi_value) + " (oversold<30), High confidence=" + std::to_string((int)(confidence*100)) + "%";
-            }
-            else if (rsi_overbought && high_confidence) {
-                result.signal = Signal::SELL;
-                result.reason = "SELL: RSI=" + std::to_string((int)rsi_value) + " (overbought>70), High confidence=" + std::to_string((int)(confidence*100)) + "%";
-            }
-            else {
-                result.signal = Signal::HOLD;
-                
-                result.reason = "HOLD";
-            }
-            
-            results.push_back(result);
+        for (size_t i = warmup_periods; i < closes.size(); ++i) {
+            StrategyResult result = on_bar(closes[i]);
+            result.timestamp_ns = bars_.timestamp_ns[i];
+            on_signal(result);
         }
         
-        // Return backtest results
+        QUANTLAB_PROFILE_COUNT(BARS_BACKTESTED, closes.size() - warmup_periods);
+        return closes.size() - warmup_periods;
+    }
+    
+    // Materialized backtest: every bar's signal, oldest first
+    // Convenient for analysis; prefer the streaming overload above when looping over the results anyway
+    std::vector<StrategyResult> backtest() {
+        std::vector<StrategyResult> results;
+        results.reserve(bars_.size() - warmup_bars(bars_.size()));
+        backtest([&results](const StrategyResult& result) { results.push_back(result); });
         return results;
     }
     
@@ -364,7 +594,7 @@ public:
                   << " | RSI: " << result.rsi_value 
                   << " | Confidence: " << (result.confidence * 100) << "%";
         if (result.signal != Signal::HOLD) {
-            std::cout << " | " << result.reason;
+            std::cout << " | " << result.reason.to_string();
         }
         std::cout << std::endl;
     }
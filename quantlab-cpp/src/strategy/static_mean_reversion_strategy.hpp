@@ -0,0 +1,218 @@
+#pragma once
+
+#include "mean_reversion_strategy.hpp"
+#include "../indicators/static_indicators.hpp"
+#include <tuple>
+#include <concepts>
+
+namespace quantlab::strategy {
+
+/**
+ * Compile-time parameters of the mean-reversion pipeline
+ *
+ * A structural type, so a whole configuration can be passed as a template
+ * argument. Defaults are MeanReversionStrategy's defaults.
+ */
+struct MeanReversionConfig {
+    int ema_period = 20;
+    int rsi_period = 14;
+    int bb_period = 20;
+    double bb_std_dev = 2.0;
+    int rsi_oversold = 30;
+    int rsi_overbought = 70;
+    double confidence_threshold = 0.65;
+
+    // Confidence factor weights (see MeanReversionStrategy::calculate_confidence)
+    double rsi_weight = 0.35;
+    double bb_weight = 0.30;
+    double trend_weight = 0.20;
+    double vol_weight = 0.15;
+};
+
+/**
+ * Indicator values of one bar, filled in by the pipeline stages
+ */
+struct BarFeatures {
+    double close = 0.0;
+    double ema = 0.0;
+    double rsi = 0.0;
+    quantlab::indicators::BollingerBandsResult bands{0.0, 0.0, 0.0};
+};
+
+// One step of a StaticMeanReversionStrategy pipeline: updates on the close, writes its feature
+template<typename T>
+concept PipelineStage = requires(T stage, BarFeatures& features) {
+    stage.update(features);
+    stage.reset();
+};
+
+template<int Period>
+struct EmaStage {
+    quantlab::indicators::StaticEMA<Period> ema;
+    void update(BarFeatures& features) { features.ema = ema.update(features.close); }
+    void reset() { ema.reset(); }
+};
+
+template<int Period>
+struct RsiStage {
+    quantlab::indicators::StaticRSI<Period> rsi;
+    void update(BarFeatures& features) { features.rsi = rsi.update(features.close); }
+    void reset() { rsi.reset(); }
+};
+
+template<int Period, double StdDevMultiplier>
+struct BollingerStage {
+    quantlab::indicators::StaticBollingerBands<Period, StdDevMultiplier> bb;
+    void update(BarFeatures& features) { features.bands = bb.update(features.close); }
+    void reset() { bb.reset(); }
+};
+
+/**
+ * Mean reversion with everything fixed at compile time
+ *
+ * The rules are MeanReversionStrategy's (RSI extreme + weighted confidence
+ * above the threshold), but the indicators are a variadic pack of stages
+ * and every threshold and weight is a constant of Config. One bar is a
+ * fold over the stages followed by the confidence formula, which the
+ * compiler can inline into a single loop body - no indicator objects on
+ * the heap, no member loads for thresholds, and every division by a
+ * constant (period, 30, total weight) turned into a multiplication.
+ *
+ * For the same configuration it produces the same signals as the runtime
+ * strategy; indicator values and confidence can differ in the last bit, so
+ * a confidence sitting exactly on the threshold could in principle flip
+ * (apps/strategy_benchmark checks the signals and measures the gap).
+ * The runtime MeanReversionStrategy stays the one the optimizer and the
+ * dashboard use, since their parameters are only known at run time.
+ *
+ *   using Fast = MeanReversionPipeline<MeanReversionConfig{.ema_period = 50}>;
+ */
+template<MeanReversionConfig Config, PipelineStage... Stages>
+class StaticMeanReversionStrategy {
+private:
+    std::tuple<Stages...> stages_;
+    quantlab::core::BarColumnsView bars_;
+
+    static constexpr double TOTAL_WEIGHT = Config.rsi_weight + Config.bb_weight + Config.trend_weight + Config.vol_weight;
+    static_assert(TOTAL_WEIGHT > 0.0, "Confidence weights must not all be zero");
+
+public:
+    static constexpr MeanReversionConfig config() { return Config; }
+
+    // Backtest on bars owned elsewhere (no copy; the caller keeps the storage alive)
+    void use_historical_data(quantlab::core::BarColumnsView bars) { bars_ = bars; }
+    const quantlab::core::BarColumnsView& bars() const { return bars_; }
+
+    // Same factors as MeanReversionStrategy::calculate_confidence, constant divisions as multiplies
+    // RSI is scored against the fixed 30/70 zones there too, independent of the signal thresholds
+    static double calculate_confidence(const BarFeatures& f) {
+        const double price = f.close;
+        const double bb_upper = f.bands.upper_band;
+        const double bb_middle = f.bands.middle_band;
+        const double bb_lower = f.bands.lower_band;
+        double total_score = 0.0;
+
+        double rsi_score = 0.0;
+        if (f.rsi <= 30) {
+            rsi_score = (30 - f.rsi) * (1.0 / 30.0);
+        } else if (f.rsi >= 70) {
+            rsi_score = (f.rsi - 70) * (1.0 / 30.0);
+        }
+        total_score += std::min(1.0, rsi_score) * Config.rsi_weight;
+
+        double bb_score = 0.0;
+        double bb_width = bb_upper - bb_lower;
+        if (bb_width > 0) {
+            if (price < bb_lower) {
+                bb_score = (bb_lower - price) / bb_width;
+            } else if (price > bb_upper) {
+                bb_score = (price - bb_upper) / bb_width;
+            }
+            bb_score = std::min(1.0, bb_score);
+        }
+        total_score += bb_score * Config.bb_weight;
+
+        double price_vs_ema = (price - f.ema) / f.ema;
+        total_score += std::min(1.0, std::abs(price_vs_ema) * 10) * Config.trend_weight;
+
+        double vol_score = 0.0;
+        if (bb_width > 0 && bb_middle > 0) {
+            vol_score = std::min(1.0, bb_width / bb_middle * 20);
+        }
+        total_score += vol_score * Config.vol_weight;
+
+        return 0.5 + total_score * (0.45 / TOTAL_WEIGHT);
+    }
+
+    // Signal for one bar given its features
+    static StrategyResult evaluate(const BarFeatures& f) {
+        const double confidence = calculate_confidence(f);
+
+        StrategyResult result;
+        result.current_price = f.close;
+        result.ema_value = f.ema;
+        result.rsi_value = f.rsi;
+        result.bb_upper = f.bands.upper_band;
+        result.bb_middle = f.bands.middle_band;
+        result.bb_lower = f.bands.lower_band;
+        result.confidence = confidence;
+
+        const bool high_confidence = confidence >= Config.confidence_threshold;
+        if (f.rsi < Config.rsi_oversold && high_confidence) {
+            result.signal = Signal::BUY;
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERSOLD, f.rsi, confidence, Config.confidence_threshold};
+        } else if (f.rsi > Config.rsi_overbought && high_confidence) {
+            result.signal = Signal::SELL;
+            result.reason = {quantlab::core::ReasonCode::RSI_OVERBOUGHT, f.rsi, confidence, Config.confidence_threshold};
+        } else {
+            result.signal = Signal::HOLD;
+            result.reason = {quantlab::core::ReasonCode::HOLD, f.rsi, confidence, Config.confidence_threshold};
+        }
+        return result;
+    }
+
+    void reset_indicators() {
+        std::apply([](auto&... stage) { (stage.reset(), ...); }, stages_);
+    }
+
+    // Run every stage on this close
+    BarFeatures update(double close) {
+        BarFeatures features;
+        features.close = close;
+        std::apply([&features](auto&... stage) { (stage.update(features), ...); }, stages_);
+        return features;
+    }
+
+    void warm_up_bar(double close) { update(close); }
+
+    StrategyResult on_bar(double close) { return evaluate(update(close)); }
+
+    // Streaming backtest with MeanReversionStrategy::backtest's warm-up; returns the number of signals
+    template<typename SignalSink>
+    size_t backtest(SignalSink&& on_signal) {
+        if (bars_.empty()) {
+            std::cout << "Error: No historical data available for backtesting!" << std::endl;
+            return 0;
+        }
+        reset_indicators();
+
+        std::span<const double> closes = bars_.close;
+        const size_t warmup_periods = MeanReversionStrategy::warmup_bars(closes.size());
+        for (size_t i = 0; i < warmup_periods; ++i) {
+            warm_up_bar(closes[i]);
+        }
+        for (size_t i = warmup_periods; i < closes.size(); ++i) {
+            StrategyResult result = on_bar(closes[i]);
+            result.timestamp_ns = bars_.timestamp_ns[i];
+            on_signal(result);
+        }
+        return closes.size() - warmup_periods;
+    }
+};
+
+// The standard EMA -> RSI -> Bollinger pipeline for a configuration
+template<MeanReversionConfig Config = MeanReversionConfig{}>
+using MeanReversionPipeline = StaticMeanReversionStrategy<Config,
+    EmaStage<Config.ema_period>, RsiStage<Config.rsi_period>, BollingerStage<Config.bb_period, Config.bb_std_dev>>;
+
+} // namespace quantlab::strategy
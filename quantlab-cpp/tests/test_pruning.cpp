@@ -0,0 +1,51 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <vector>
+#include "../src/optimization/pruning.hpp"
+
+using quantlab::backtest::BacktestEngine;
+using quantlab::backtest::MarketEvent;
+using quantlab::optimization::SimplePruningPolicy;
+using quantlab::optimization::TrialProgress;
+
+namespace {
+
+struct Lane {
+    BacktestEngine engine{1000000.0};
+    bool pruned = false;
+    double stop_price = 0.0;
+};
+
+MarketEvent bar_at(int64_t t, double close) {
+    return MarketEvent{t, close, close, close, close};
+}
+
+} // namespace
+
+TEST_CASE("Pruned lanes are finalized at the close of their stop bar", "[pruning]") {
+    // Halve the cohort at the midpoint of a 4-bar window: the flat lane outranks the losing long one
+    SimplePruningPolicy policy(0.0, 0, 0.5, {0.5}, 2.0);
+    std::vector<Lane> lanes(2);
+    std::vector<size_t> alive{0, 1};
+    const std::vector<double> closes{100.0, 80.0, 150.0, 150.0};
+    
+    for (size_t bar = 0; bar < closes.size() && !alive.empty(); ++bar) {
+        for (size_t l : alive) {
+            lanes[l].engine.on_bar(bar_at(static_cast<int64_t>(bar), closes[bar]));
+            if (l == 1 && bar == 0) {
+                lanes[l].engine.on_signal(quantlab::core::TradeAction::BUY, 1.0, {});  // 500 shares at 100
+            }
+        }
+        quantlab::optimization::prune_lanes(policy, lanes, alive, TrialProgress{bar + 1, closes.size()},
+                                            closes[bar]);
+    }
+    
+    REQUIRE_FALSE(lanes[0].pruned);
+    REQUIRE(lanes[1].pruned);
+    REQUIRE(lanes[1].stop_price == 80.0);
+    REQUIRE(lanes[1].engine.get_portfolio().shares_held == 500);
+    
+    // Marked at the stop bar, not at the window's last close it never traded through
+    lanes[1].engine.calculate_final_metrics(lanes[1].stop_price);
+    CHECK(lanes[1].engine.get_metrics().total_return_pct == Catch::Approx(-1.0));
+}
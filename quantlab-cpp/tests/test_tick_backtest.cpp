@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <vector>
+#include "../src/backtest/strategy_runner.hpp"
+#include "../src/data/synthetic_data.hpp"
+
+using quantlab::backtest::BacktestEngine;
+using quantlab::core::Tick;
+using quantlab::strategy::MeanReversionStrategy;
+
+TEST_CASE("TickBacktest matches run_strategy_backtest on the same bars", "[backtest][ticks]") {
+    quantlab::data::SyntheticConfig config;
+    config.model = quantlab::data::SyntheticModel::ORNSTEIN_UHLENBECK;  // Mean-reverting: plenty of signals
+    config.volatility = 0.4;
+    const auto bars = quantlab::data::generate_bars(config, 400);
+    const auto view = bars.view();
+    
+    // Four ticks per one-minute bar (open, high, low, close) rebuild exactly these bars
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < view.size(); ++i) {
+        const int64_t t = view.timestamp_ns[i];
+        const int64_t second = quantlab::core::NANOS_PER_SECOND;
+        ticks.emplace_back(t, view.open[i], 1);
+        ticks.emplace_back(t + second, view.high[i], 1);
+        ticks.emplace_back(t + 2 * second, view.low[i], 1);
+        ticks.emplace_back(t + 3 * second, view.close[i], 1);
+    }
+    
+    MeanReversionStrategy bar_strategy(20, 14, 20, 2.0, nullptr);
+    bar_strategy.use_historical_data(view);
+    BacktestEngine bar_engine(1000000.0);
+    double bar_price = quantlab::backtest::run_strategy_backtest(bar_strategy, bar_engine, 0.3, 100.0);
+    
+    MeanReversionStrategy tick_strategy(20, 14, 20, 2.0, nullptr);
+    BacktestEngine tick_engine(1000000.0);
+    quantlab::backtest::TickBacktest backtest(tick_strategy, tick_engine, quantlab::core::BarAggregator::minute_bars(),
+                                              0.3, MeanReversionStrategy::warmup_bars(view.size()));
+    backtest.on_ticks(ticks);
+    double tick_price = backtest.finish();
+    
+    REQUIRE(backtest.bars() == view.size());
+    REQUIRE(tick_price == bar_price);
+    
+    const auto& expected = bar_engine.get_metrics();
+    const auto& actual = tick_engine.get_metrics();
+    REQUIRE(expected.total_trades > 0);
+    CHECK(tick_engine.accumulator().marks() == bar_engine.accumulator().marks());
+    CHECK(actual.total_trades == expected.total_trades);
+    CHECK(actual.total_return_pct == Catch::Approx(expected.total_return_pct));
+    CHECK(actual.sharpe_ratio == Catch::Approx(expected.sharpe_ratio));
+    CHECK(actual.max_drawdown_pct == Catch::Approx(expected.max_drawdown_pct));
+}
@@ -4,6 +4,8 @@ const helmet = require('helmet');
 const compression = require('compression');
 const { spawn } = require('child_process');
 const path = require('path');
+const net = require('net');
+const readline = require('readline');
 
 const app = express();
 const PORT = process.env.PORT || 8080;
@@ -112,7 +114,7 @@ app.post('/optimize', async (req, res) => {
       'Surrogate-Control': 'no-store'
     });
     
-    res.status(500).json({
+    res.status(error.rpcCode === -32602 ? 400 : 500).json({
       success: false,
       error: error.message,
       timestamp: new Date().toISOString(),
@@ -121,22 +123,187 @@ app.post('/optimize', async (req, res) => {
   }
 });
 
-// Helper function to run C++ backtesting engine
+// Environment for the C++ processes (Alpaca API credentials)
+function optimizerEnv() {
+  return {
+    ...process.env,
+    ALPACA_API_KEY_ID: process.env.ALPACA_API_KEY_ID || 'DEMO_KEY',
+    ALPACA_API_SECRET_KEY: process.env.ALPACA_API_SECRET_KEY || 'DEMO_SECRET',
+    ALPACA_BASE_URL: process.env.ALPACA_BASE_URL || 'https://paper-api.alpaca.markets',
+    ALPACA_PAPER: '1'
+  };
+}
+
+// Long-lived C++ optimizer (`strategy_optimizer --serve`): JSON-RPC 2.0 over a Unix socket,
+// one message per line. The child keeps histories loaded between requests, so only the first
+// request for a symbol pays for process startup and the download.
+const OPTIMIZER_SOCKET = process.env.OPTIMIZER_SOCKET || '/tmp/quantlab_optimizer.sock';
+const OPTIMIZER_WORKERS = process.env.OPTIMIZER_WORKERS || '4';
+const RPC_TIMEOUT_MS = 120000;
+const CONNECT_TIMEOUT_MS = 10000;
+const SHUTDOWN_TIMEOUT_MS = 9000; // Cloud Run kills the container 10 s after SIGTERM
+// Connect errors meaning nothing listens on the socket; only these fall back to a one-off process
+const SERVICE_UNREACHABLE = new Set(['ECONNREFUSED', 'ENOENT']);
+
+class OptimizerService {
+  constructor() {
+    this.child = null;
+    this.socket = null;
+    this.connecting = null;
+    this.pending = new Map(); // id -> { resolve, reject, timer }
+    this.drainWaiters = [];
+    this.nextId = 1;
+  }
+
+  start() {
+    if (this.child) return;
+    const binary = path.join(__dirname, 'strategy_optimizer');
+    console.log(`🛰️  Starting optimizer service: ${binary} --serve ${OPTIMIZER_SOCKET} ${OPTIMIZER_WORKERS}`);
+    const child = spawn(binary, ['--serve', OPTIMIZER_SOCKET, OPTIMIZER_WORKERS], { env: optimizerEnv(), cwd: __dirname });
+    child.stdout.on('data', (data) => console.log('📈 [service]', data.toString().trim()));
+    child.stderr.on('data', (data) => console.log('🔍 [service]', data.toString().trim()));
+    const onExit = (reason) => {
+      if (this.child !== child) return;
+      console.error(`⚠️  Optimizer service stopped: ${reason}`);
+      this.child = null;
+      this.reset(new Error(`Optimizer service stopped: ${reason}`));
+    };
+    child.on('exit', (code, signal) => onExit(signal || `code ${code}`));
+    child.on('error', (error) => onExit(error.message));
+    this.child = child;
+  }
+
+  // SIGTERM the child (it answers what is queued first); resolves once it has exited
+  stop() {
+    const child = this.child;
+    if (!child) return Promise.resolve();
+    return new Promise((resolve) => {
+      child.once('exit', () => resolve());
+      child.kill('SIGTERM');
+    });
+  }
+
+  // Resolves once no call is waiting for a response
+  drained() {
+    if (this.pending.size === 0) return Promise.resolve();
+    return new Promise((resolve) => this.drainWaiters.push(resolve));
+  }
+
+  settle(id) {
+    this.pending.delete(id);
+    if (this.pending.size > 0) return;
+    for (const resolve of this.drainWaiters.splice(0)) resolve();
+  }
+
+  // Fail everything in flight; the next call reconnects (and restarts the child if needed)
+  reset(error) {
+    if (this.socket) this.socket.destroy();
+    this.socket = null;
+    for (const { reject, timer } of this.pending.values()) {
+      clearTimeout(timer);
+      reject(error);
+    }
+    for (const id of [...this.pending.keys()]) this.settle(id);
+  }
+
+  connect() {
+    if (this.socket) return Promise.resolve(this.socket);
+    if (this.connecting) return this.connecting;
+    this.start();
+
+    this.connecting = new Promise((resolve, reject) => {
+      const deadline = Date.now() + CONNECT_TIMEOUT_MS;
+      const attempt = () => {
+        const socket = net.createConnection(OPTIMIZER_SOCKET);
+        const onConnectError = (error) => {
+          socket.destroy();
+          if (Date.now() > deadline || !this.child) {
+            this.connecting = null;
+            reject(error);
+            return;
+          }
+          setTimeout(attempt, 100); // Service still starting up
+        };
+        socket.once('error', onConnectError);
+        socket.once('connect', () => {
+          socket.removeListener('error', onConnectError);
+          socket.on('error', (error) => console.error('❌ Optimizer socket error:', error.message));
+          socket.on('close', () => {
+            if (this.socket === socket) this.reset(new Error('Optimizer service connection closed'));
+          });
+          readline.createInterface({ input: socket }).on('line', (line) => this.onLine(line));
+          this.socket = socket;
+          this.connecting = null;
+          resolve(socket);
+        });
+      };
+      attempt();
+    });
+    return this.connecting;
+  }
+
+  onLine(line) {
+    let message;
+    try {
+      message = JSON.parse(line);
+    } catch (error) {
+      console.error('❌ Unparseable optimizer response:', line);
+      return;
+    }
+    const entry = this.pending.get(message.id);
+    if (!entry) return;
+    this.settle(message.id);
+    clearTimeout(entry.timer);
+    if (message.error) {
+      const error = new Error(message.error.message);
+      error.rpcCode = message.error.code; // -32602 = invalid params
+      entry.reject(error);
+    } else {
+      entry.resolve(message.result);
+    }
+  }
+
+  async call(method, params = {}) {
+    const socket = await this.connect();
+    const id = this.nextId++;
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        this.settle(id);
+        reject(new Error(`${method} timed out after ${RPC_TIMEOUT_MS} ms`));
+      }, RPC_TIMEOUT_MS);
+      this.pending.set(id, { resolve, reject, timer });
+      socket.write(JSON.stringify({ jsonrpc: '2.0', id, method, params }) + '\n');
+    });
+  }
+}
+
+const optimizerService = new OptimizerService();
+
+// Run an optimization on the persistent service; fall back to a one-off process only if the
+// socket is unreachable. Errors the service answers with (bad parameters, timeouts) are the
+// caller's: a one-off run would fail the same way or pile more load on a busy machine.
 async function runCppOptimizer(parameters) {
+  try {
+    const started = Date.now();
+    const results = await optimizerService.call('optimize', parameters);
+    console.log(`⚡ Optimizer service answered in ${Date.now() - started} ms`);
+    return results;
+  } catch (error) {
+    if (!SERVICE_UNREACHABLE.has(error.code)) throw error;
+    console.error('⚠️  Optimizer service unreachable, spawning a one-off process:', error.message);
+    return runCppOptimizerProcess(parameters);
+  }
+}
+
+// Helper function to run C++ backtesting engine as a one-off process
+async function runCppOptimizerProcess(parameters) {
   return new Promise((resolve, reject) => {
     const backtestPath = path.join(__dirname, 'strategy_optimizer');
     
     console.log('🔧 Running real backtesting engine:', backtestPath);
     console.log('📊 Parameters:', parameters);
 
-    // Set environment variables for Alpaca API
-    const env = {
-      ...process.env,
-      ALPACA_API_KEY_ID: process.env.ALPACA_API_KEY_ID || 'DEMO_KEY',
-      ALPACA_API_SECRET_KEY: process.env.ALPACA_API_SECRET_KEY || 'DEMO_SECRET',
-      ALPACA_BASE_URL: process.env.ALPACA_BASE_URL || 'https://paper-api.alpaca.markets',
-      ALPACA_PAPER: '1'
-    };
+    const env = optimizerEnv();
 
     // The institutional_backtest takes: symbol, days, confidence_threshold, oversold_threshold, overbought_threshold
     const symbol = parameters.symbol || 'AAPL';
@@ -259,11 +426,42 @@ app.use((error, req, res, next) => {
 });
 
 // Start server
-app.listen(PORT, '0.0.0.0', () => {
+const httpServer = app.listen(PORT, '0.0.0.0', () => {
   console.log(`🚀 Strategy Optimizer API running on port ${PORT}`);
   console.log(`🌐 Health check: http://localhost:${PORT}/health`);
   console.log(`📊 Optimization endpoint: http://localhost:${PORT}/optimize`);
   console.log(`ℹ️  Info endpoint: http://localhost:${PORT}/info`);
+
+  // Warm the optimizer service up before the first request arrives
+  optimizerService.connect().catch((error) => {
+    console.error('⚠️  Optimizer service not available yet:', error.message);
+  });
 });
 
+// Cloud Run sends SIGTERM on shutdown: stop accepting requests, let the ones in flight finish,
+// then stop the optimizer child and wait for it before exiting
+let shuttingDown = false;
+async function shutdown(signal) {
+  if (shuttingDown) return;
+  shuttingDown = true;
+  console.log(`👋 ${signal} received, draining in-flight requests`);
+  setTimeout(() => {
+    console.error(`⚠️  Shutdown still waiting after ${SHUTDOWN_TIMEOUT_MS} ms, exiting`);
+    process.exit(1);
+  }, SHUTDOWN_TIMEOUT_MS).unref();
+
+  await new Promise((resolve) => {
+    httpServer.close(resolve); // Resolves once every open request has been answered
+    httpServer.closeIdleConnections();
+  });
+  await optimizerService.drained();
+  await optimizerService.stop();
+  process.exit(0);
+}
+
+process.on('exit', () => optimizerService.stop());
+for (const signal of ['SIGTERM', 'SIGINT']) {
+  process.on(signal, () => shutdown(signal));
+}
+
 module.exports = app;
\ No newline at end of file